@@ -0,0 +1,395 @@
+#define _POSIX_C_SOURCE 199309L  // clock_gettime
+
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+#include <stdio.h>    // printf, fprintf
+#include <stdlib.h>   // strtoul
+#include <string.h>   // strcmp, strstr, strncmp
+#include <time.h>     // clock_gettime
+
+#include "corpus.h"
+
+#include "bcs/decoder.h"
+#include "bcs/utf8.h"
+#include "common/buffer.h"
+#include "common/format.h"
+#include "transaction/deserialize.h"
+#include "transaction/types.h"
+#include "transaction/utils.h"
+
+/**
+ * Benchmarked operation, returns false if the operation failed.
+ */
+typedef bool (*bench_fn_t)(const void *arg);
+
+typedef struct {
+    const char *name;    /// benchmarked function
+    const char *input;   /// name of input
+    bench_fn_t fn;       /// operation run in a loop
+    const void *arg;     /// argument of operation
+    size_t bytes;        /// bytes processed per operation
+} bench_t;
+
+typedef struct {
+    uint64_t iterations;
+    double ns_per_op;
+    double bytes_per_sec;
+} bench_result_t;
+
+typedef enum { OUTPUT_JSON, OUTPUT_TEXT } output_format_e;
+
+// Keeps results of operations alive so that the compiler can't drop them
+static volatile uint64_t g_sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * Run operation in batches of growing size until min_time_ns is elapsed.
+ */
+static bool bench_run(const bench_t *bench, uint64_t min_time_ns, bench_result_t *result) {
+    uint64_t batch = 1;
+    uint64_t iterations = 0;
+    uint64_t elapsed = 0;
+
+    // warm up caches and branch predictors
+    for (int i = 0; i < 100; i++) {
+        if (!bench->fn(bench->arg)) {
+            return false;
+        }
+    }
+
+    while (elapsed < min_time_ns) {
+        const uint64_t start = now_ns();
+        for (uint64_t i = 0; i < batch; i++) {
+            bench->fn(bench->arg);
+        }
+        elapsed += now_ns() - start;
+        iterations += batch;
+        if (batch < (1ULL << 20)) {
+            batch *= 2;
+        }
+    }
+
+    result->iterations = iterations;
+    result->ns_per_op = (double) elapsed / (double) iterations;
+    result->bytes_per_sec = (double) bench->bytes * 1e9 / result->ns_per_op;
+
+    return true;
+}
+
+/* ---------- bcs_read_u32_from_uleb128 ---------- */
+
+typedef struct {
+    uint8_t bytes[64];
+    size_t len;
+    size_t count;
+} uleb_input_t;
+
+static void uleb_input_build(uleb_input_t *input, const uint32_t *values, size_t count) {
+    input->len = 0;
+    input->count = count;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t value = values[i];
+        while (value >= 0x80) {
+            input->bytes[input->len++] = (uint8_t) (value & 0x7F) | 0x80;
+            value >>= 7;
+        }
+        input->bytes[input->len++] = (uint8_t) value;
+    }
+}
+
+static bool bench_uleb128(const void *arg) {
+    const uleb_input_t *input = arg;
+    buffer_t buf = {.ptr = input->bytes, .size = input->len, .offset = 0};
+    uint32_t value = 0;
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < input->count; i++) {
+        if (!bcs_read_u32_from_uleb128(&buf, &value)) {
+            return false;
+        }
+        sum += value;
+    }
+    g_sink += sum;
+
+    return true;
+}
+
+/* ---------- bcs_read_string ---------- */
+
+typedef struct {
+    uint8_t bytes[256];
+    size_t len;
+    size_t count;
+} string_input_t;
+
+static void string_input_build(string_input_t *input, const char *const *strings, size_t count) {
+    input->len = 0;
+    input->count = count;
+    for (size_t i = 0; i < count; i++) {
+        const size_t len = strlen(strings[i]);
+        input->bytes[input->len++] = (uint8_t) len;
+        memcpy(input->bytes + input->len, strings[i], len);
+        input->len += len;
+    }
+}
+
+static bool bench_read_string(const void *arg) {
+    const string_input_t *input = arg;
+    buffer_t buf = {.ptr = input->bytes, .size = input->len, .offset = 0};
+    unsigned char out[128];
+    size_t out_len = 0;
+
+    for (size_t i = 0; i < input->count; i++) {
+        if (!bcs_read_string(&buf, out, sizeof(out), &out_len)) {
+            return false;
+        }
+        g_sink += out_len;
+    }
+
+    return true;
+}
+
+/* ---------- try_utf8_to_ascii ---------- */
+
+typedef struct {
+    const uint8_t *bytes;
+    size_t len;
+} bytes_input_t;
+
+static bool bench_utf8_to_ascii(const void *arg) {
+    const bytes_input_t *input = arg;
+    uint8_t out[512];
+    bool is_utf8 = false;
+
+    const int len = try_utf8_to_ascii(input->bytes, input->len, out, sizeof(out), &is_utf8);
+    g_sink += (uint64_t) len + is_utf8;
+
+    return len >= 0;
+}
+
+/* ---------- transaction_utils_check_encoding ---------- */
+
+static bool bench_check_encoding(const void *arg) {
+    const bytes_input_t *input = arg;
+
+    const bool is_ascii = transaction_utils_check_encoding(input->bytes, input->len);
+    g_sink += is_ascii;
+
+    return is_ascii;
+}
+
+/* ---------- transaction_deserialize ---------- */
+
+static bool bench_deserialize(const void *arg) {
+    static transaction_t tx;
+    const corpus_item_t *item = arg;
+    buffer_t buf = {.ptr = item->bytes, .size = item->len, .offset = 0};
+
+    const parser_status_e status = transaction_deserialize(&buf, &tx);
+    g_sink += tx.sequence;
+
+    return status == PARSING_OK;
+}
+
+/* ---------- format_fpu64 ---------- */
+
+static bool bench_format_fpu64(const void *arg) {
+    const uint64_t *value = arg;
+    char out[30];
+
+    if (!format_fpu64(out, sizeof(out), *value, 8)) {
+        return false;
+    }
+    g_sink += (uint8_t) out[0];
+
+    return true;
+}
+
+/* ---------- format_fpu128 ---------- */
+
+static bool bench_format_fpu128(const void *arg) {
+    const uint128_t *value = arg;
+    char out[60];
+
+    if (!format_fpu128(out, sizeof(out), value, 8)) {
+        return false;
+    }
+    g_sink += (uint8_t) out[0];
+
+    return true;
+}
+
+static void print_usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [--format json|text] [--min-time-ms N] [--filter SUBSTRING]\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    output_format_e format = OUTPUT_JSON;
+    uint64_t min_time_ns = 200ULL * 1000000ULL;
+    const char *filter = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "json") == 0) {
+                format = OUTPUT_JSON;
+            } else if (strcmp(argv[i], "text") == 0) {
+                format = OUTPUT_TEXT;
+            } else {
+                print_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            min_time_ns = strtoull(argv[++i], NULL, 10) * 1000000ULL;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    static corpus_item_t corpus[CORPUS_SIZE];
+    corpus_build(corpus);
+
+    // single and multi-byte encodings as found in lengths, variants and counts
+    static const uint32_t uleb_small[] = {0, 1, 2, 7, 32, 8, 4, 127};
+    static const uint32_t uleb_large[] = {128, 300, 16383, 16384, 2097151, 2097152, 268435455,
+                                          UINT32_MAX};
+    static uleb_input_t uleb_small_input;
+    static uleb_input_t uleb_large_input;
+    uleb_input_build(&uleb_small_input, uleb_small, sizeof(uleb_small) / sizeof(uleb_small[0]));
+    uleb_input_build(&uleb_large_input, uleb_large, sizeof(uleb_large) / sizeof(uleb_large[0]));
+
+    // module, function and struct names of framework transactions
+    static const char *const names[] = {"aptos_account",
+                                        "transfer",
+                                        "coin",
+                                        "aptos_coin",
+                                        "AptosCoin",
+                                        "delegation_pool",
+                                        "add_stake",
+                                        "reactivate_stake"};
+    static string_input_t names_input;
+    string_input_build(&names_input, names, sizeof(names) / sizeof(names[0]));
+
+    static const char ascii_text[] =
+        "Sign in to the marketplace to list your tokens. This request will not trigger a "
+        "blockchain transaction or cost any gas fees. Nonce: 1667597331, chain: mainnet.";
+    static const char utf8_text[] =
+        "Connexion \xc3\xa0 la place de march\xc3\xa9 \xe2\x80\x94 signer ce message "
+        "n'entra\xc3\xae"
+        "ne aucun frais \xe2\x9c\x93 \xf0\x9f\x9a\x80 nonce 1667597331";
+    static const bytes_input_t ascii_input = {(const uint8_t *) ascii_text,
+                                              sizeof(ascii_text) - 1};
+    static const bytes_input_t utf8_input = {(const uint8_t *) utf8_text, sizeof(utf8_text) - 1};
+    // largest message a device accepts
+    static uint8_t message[MAX_TX_LEN];
+    for (size_t i = 0; i < sizeof(message); i++) {
+        message[i] = (uint8_t) ascii_text[i % (sizeof(ascii_text) - 1)];
+    }
+    static const bytes_input_t message_input = {message, sizeof(message)};
+
+    static const uint64_t amount_small = 717;
+    static const uint64_t amount_large = 18446744073709551615ULL;
+    static const uint128_t amount_u128_max = {18446744073709551615ULL, 18446744073709551615ULL};
+
+    bench_t benches[10 + CORPUS_SIZE] = {
+        {"bcs_read_u32_from_uleb128",
+         "1_byte_x8",
+         bench_uleb128,
+         &uleb_small_input,
+         uleb_small_input.len},
+        {"bcs_read_u32_from_uleb128",
+         "multi_byte_x8",
+         bench_uleb128,
+         &uleb_large_input,
+         uleb_large_input.len},
+        {"bcs_read_string", "names_x8", bench_read_string, &names_input, names_input.len},
+        {"try_utf8_to_ascii", "ascii", bench_utf8_to_ascii, &ascii_input, ascii_input.len},
+        {"try_utf8_to_ascii", "utf8", bench_utf8_to_ascii, &utf8_input, utf8_input.len},
+        {"transaction_utils_check_encoding",
+         "ascii_max_tx_len",
+         bench_check_encoding,
+         &message_input,
+         message_input.len},
+        {"format_fpu64", "small", bench_format_fpu64, &amount_small, sizeof(uint64_t)},
+        {"format_fpu64", "u64_max", bench_format_fpu64, &amount_large, sizeof(uint64_t)},
+        {"format_fpu128",
+         "u128_max",
+         bench_format_fpu128,
+         &amount_u128_max,
+         sizeof(uint128_t)},
+    };
+    size_t count = 9;
+    for (size_t i = 0; i < CORPUS_SIZE; i++) {
+        benches[count++] = (bench_t){"transaction_deserialize",
+                                     corpus[i].name,
+                                     bench_deserialize,
+                                     &corpus[i],
+                                     corpus[i].len};
+    }
+
+    bool first = true;
+    int ret = 0;
+    if (format == OUTPUT_JSON) {
+        printf("{\n  \"min_time_ms\": %llu,\n  \"benchmarks\": [",
+               (unsigned long long) (min_time_ns / 1000000ULL));
+    } else {
+        printf("%-32s %-16s %12s %12s %14s\n", "function", "input", "iterations", "ns/op", "MB/s");
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const bench_t *bench = &benches[i];
+        bench_result_t result;
+        char full_name[96];
+
+        snprintf(full_name, sizeof(full_name), "%s/%s", bench->name, bench->input);
+        if (filter != NULL && strstr(full_name, filter) == NULL) {
+            continue;
+        }
+        if (!bench_run(bench, min_time_ns, &result)) {
+            fprintf(stderr, "%s failed\n", full_name);
+            ret = 1;
+            continue;
+        }
+
+        if (format == OUTPUT_JSON) {
+            printf("%s\n    {\"name\": \"%s\", \"function\": \"%s\", \"input\": \"%s\", "
+                   "\"iterations\": %llu, \"bytes_per_op\": %zu, \"ns_per_op\": %.2f, "
+                   "\"bytes_per_sec\": %.0f}",
+                   first ? "" : ",",
+                   full_name,
+                   bench->name,
+                   bench->input,
+                   (unsigned long long) result.iterations,
+                   bench->bytes,
+                   result.ns_per_op,
+                   result.bytes_per_sec);
+        } else {
+            printf("%-32s %-16s %12llu %12.2f %14.2f\n",
+                   bench->name,
+                   bench->input,
+                   (unsigned long long) result.iterations,
+                   result.ns_per_op,
+                   result.bytes_per_sec / 1e6);
+        }
+        first = false;
+    }
+
+    if (format == OUTPUT_JSON) {
+        printf("\n  ]\n}\n");
+    }
+
+    return ret;
+}
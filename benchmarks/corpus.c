@@ -0,0 +1,179 @@
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint*_t
+#include <string.h>  // memcpy, memset, strlen
+
+#include "corpus.h"
+
+/**
+ * Append bytes to a corpus item, payloads of the corpus are far below
+ * MAX_TX_LEN so no bound check is done.
+ */
+static void put_bytes(corpus_item_t *item, const void *bytes, size_t len) {
+    memcpy(item->bytes + item->len, bytes, len);
+    item->len += len;
+}
+
+static void put_u8(corpus_item_t *item, uint8_t value) {
+    item->bytes[item->len++] = value;
+}
+
+static void put_u64(corpus_item_t *item, uint64_t value) {
+    for (size_t i = 0; i < 8; i++) {
+        put_u8(item, (uint8_t) (value >> (8 * i)));
+    }
+}
+
+static void put_uleb128(corpus_item_t *item, uint32_t value) {
+    while (value >= 0x80) {
+        put_u8(item, (uint8_t) (value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    put_u8(item, (uint8_t) value);
+}
+
+static void put_string(corpus_item_t *item, const char *str) {
+    put_uleb128(item, (uint32_t) strlen(str));
+    put_bytes(item, str, strlen(str));
+}
+
+/**
+ * Append address made of a repeated byte, or 0x0..0<byte> for short addresses.
+ */
+static void put_address(corpus_item_t *item, uint8_t byte, int is_short) {
+    uint8_t address[ADDRESS_LEN];
+
+    memset(address, is_short ? 0 : byte, sizeof(address));
+    address[ADDRESS_LEN - 1] = byte;
+    put_bytes(item, address, sizeof(address));
+}
+
+static void put_header(corpus_item_t *item, uint64_t sequence) {
+    put_bytes(item, PREFIX_RAW_TX_HASHED, TX_HASHED_PREFIX_LEN);
+    put_address(item, 0x86, 0);  // sender
+    put_u64(item, sequence);
+}
+
+static void put_footer(corpus_item_t *item) {
+    put_u64(item, 20000);       // max_gas_amount
+    put_u64(item, 100);         // gas_unit_price
+    put_u64(item, 1667597331);  // expiration_timestamp_secs
+    put_u8(item, 1);            // chain_id
+}
+
+static void put_entry_function(corpus_item_t *item, const char *module, const char *function) {
+    put_uleb128(item, PAYLOAD_ENTRY_FUNCTION);
+    put_address(item, 0x01, 1);
+    put_string(item, module);
+    put_string(item, function);
+}
+
+static void put_struct_tag(corpus_item_t *item,
+                           uint8_t address,
+                           const char *module,
+                           const char *name) {
+    put_uleb128(item, TYPE_TAG_STRUCT);
+    put_address(item, address, 1);
+    put_string(item, module);
+    put_string(item, name);
+    put_uleb128(item, 0);  // type args
+}
+
+static void build_transfer(corpus_item_t *item) {
+    item->name = "transfer";
+    put_header(item, 1);
+    put_entry_function(item, "aptos_account", "transfer");
+    put_uleb128(item, 0);  // type args
+    put_uleb128(item, 2);  // args
+    put_uleb128(item, ADDRESS_LEN);
+    put_address(item, 0xa7, 0);
+    put_uleb128(item, 8);
+    put_u64(item, 100000000);
+    put_footer(item);
+}
+
+static void build_coin_transfer(corpus_item_t *item) {
+    item->name = "coin_transfer";
+    put_header(item, 2);
+    put_entry_function(item, "coin", "transfer");
+    put_uleb128(item, 1);  // type args
+    put_struct_tag(item, 0x01, "aptos_coin", "AptosCoin");
+    put_uleb128(item, 2);  // args
+    put_uleb128(item, ADDRESS_LEN);
+    put_address(item, 0xa7, 0);
+    put_uleb128(item, 8);
+    put_u64(item, 717);
+    put_footer(item);
+}
+
+static void build_entry_function(corpus_item_t *item) {
+    uint8_t token_name[64];
+
+    memset(token_name, 'a', sizeof(token_name));
+
+    item->name = "entry_function";
+    put_header(item, 3);
+    put_uleb128(item, PAYLOAD_ENTRY_FUNCTION);
+    put_address(item, 0xc0, 0);
+    put_string(item, "marketplace");
+    put_string(item, "list_token_for_sale");
+    put_uleb128(item, 2);  // type args
+    put_struct_tag(item, 0x01, "aptos_coin", "AptosCoin");
+    put_uleb128(item, TYPE_TAG_VECTOR);
+    put_struct_tag(item, 0xc0, "marketplace", "Listing");
+    put_uleb128(item, 5);  // args
+    put_uleb128(item, ADDRESS_LEN);
+    put_address(item, 0xc1, 0);
+    put_uleb128(item, 1 + sizeof(token_name));
+    put_uleb128(item, sizeof(token_name));
+    put_bytes(item, token_name, sizeof(token_name));
+    put_uleb128(item, 8);
+    put_u64(item, 0);
+    put_uleb128(item, 8);
+    put_u64(item, 2500000000);
+    put_uleb128(item, 1);
+    put_u8(item, 1);
+    put_footer(item);
+}
+
+static void build_script(corpus_item_t *item) {
+    uint8_t code[300];
+
+    for (size_t i = 0; i < sizeof(code); i++) {
+        code[i] = (uint8_t) (i * 31);
+    }
+
+    item->name = "script";
+    put_header(item, 4);
+    put_uleb128(item, PAYLOAD_SCRIPT);
+    put_uleb128(item, sizeof(code));
+    put_bytes(item, code, sizeof(code));
+    put_uleb128(item, 1);  // type args
+    put_struct_tag(item, 0x01, "aptos_coin", "AptosCoin");
+    put_uleb128(item, 3);  // args
+    put_uleb128(item, SCRIPT_ARG_ADDRESS);
+    put_address(item, 0xa7, 0);
+    put_uleb128(item, SCRIPT_ARG_U64);
+    put_u64(item, 100000000);
+    put_uleb128(item, SCRIPT_ARG_BOOL);
+    put_u8(item, 0);
+    put_footer(item);
+}
+
+static void build_message(corpus_item_t *item) {
+    static const char message[] =
+        "APTOS\nmessage: Sign in to the marketplace to list your tokens. This request will "
+        "not trigger a blockchain transaction or cost any gas fees.\nnonce: 1667597331";
+
+    item->name = "message";
+    put_bytes(item, message, sizeof(message) - 1);
+}
+
+void corpus_build(corpus_item_t *corpus) {
+    memset(corpus, 0, CORPUS_SIZE * sizeof(corpus_item_t));
+
+    build_transfer(&corpus[0]);
+    build_coin_transfer(&corpus[1]);
+    build_entry_function(&corpus[2]);
+    build_script(&corpus[3]);
+    build_message(&corpus[4]);
+}
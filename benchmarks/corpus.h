@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint*_t
+
+#include "transaction/types.h"
+
+/**
+ * Serialized payload of the corpus.
+ */
+typedef struct {
+    const char *name;          /// name of payload in benchmark results
+    uint8_t bytes[MAX_TX_LEN];
+    size_t len;
+} corpus_item_t;
+
+/**
+ * Number of payloads in the corpus.
+ */
+#define CORPUS_SIZE 5
+
+/**
+ * Build the corpus of realistic signing payloads:
+ * - aptos_account::transfer
+ * - coin::transfer<AptosCoin>
+ * - entry function with generic type args and vector args
+ * - script with type args and typed args
+ * - ASCII message
+ *
+ * @param[out] corpus
+ *   Pointer to array of CORPUS_SIZE items.
+ *
+ */
+void corpus_build(corpus_item_t *corpus);
@@ -12,12 +12,14 @@ set(CMAKE_C_FLAGS_DEBUG
 )
 
 add_library(txparser SHARED
+    ${CMAKE_CURRENT_SOURCE_DIR}/../src/common/ascii.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/common/bip32.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/common/varint.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/common/read.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/common/write.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/common/buffer.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/common/format.c
+    ${CMAKE_CURRENT_SOURCE_DIR}/../src/common/uint128.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/transaction/utils.c
     ${CMAKE_CURRENT_SOURCE_DIR}/../src/transaction/deserialize.c
 )
@@ -0,0 +1,149 @@
+#include <stdint.h>   // uint*_t
+#include <stddef.h>   // size_t
+#include <stdlib.h>   // calloc, free
+#include <string.h>   // memcpy
+
+#include "aptos_ledger.h"
+#include "sha3.h"
+
+#include "constants.h"
+#include "common/buffer.h"
+#include "transaction/types.h"
+#include "transaction/deserialize.h"
+#include "transaction/fields.h"
+
+_Static_assert(APTOS_LEDGER_FIELD_VALUE_LEN >= TX_FIELD_STRUCT_LEN &&
+                   APTOS_LEDGER_FIELD_VALUE_LEN >= TX_FIELD_SIGNERS_LEN &&
+                   APTOS_LEDGER_FIELD_VALUE_LEN >= TX_FIELD_ADDRESS_LEN,
+               "field value buffer too small");
+
+struct aptos_ledger_tx {
+    uint8_t message[MAX_TRANSACTION_LEN];  /// copy of signing message, decoded fields point into it
+    size_t message_len;
+    transaction_t transaction;
+    tx_field_e fields[TX_FIELDS_MAX];
+    size_t fields_count;
+    uint8_t script_hash[SHA3_256_LEN];
+    uint8_t message_hash[SHA3_256_LEN];    /// SHA3-256 of signing message, as computed by SIGN_TX
+};
+
+aptos_ledger_tx_t *aptos_ledger_tx_new(void) {
+    return calloc(1, sizeof(aptos_ledger_tx_t));
+}
+
+void aptos_ledger_tx_free(aptos_ledger_tx_t *tx) {
+    free(tx);
+}
+
+int aptos_ledger_tx_parse(aptos_ledger_tx_t *tx, const uint8_t *message, size_t message_len) {
+    if (tx == NULL || (message == NULL && message_len > 0)) {
+        return APTOS_LEDGER_ERROR_ARGUMENT;
+    }
+
+    tx->message_len = 0;
+    tx->fields_count = 0;
+
+    if (message_len > MAX_TRANSACTION_LEN) {
+        return APTOS_LEDGER_ERROR_TOO_LONG;
+    }
+
+    if (message_len > 0) {
+        memcpy(tx->message, message, message_len);
+    }
+    tx->message_len = message_len;
+
+    buffer_t buf = {.ptr = tx->message, .size = tx->message_len, .offset = 0};
+    const parser_status_e status = transaction_deserialize(&buf, &tx->transaction);
+    if (status != PARSING_OK) {
+        return (int) status;
+    }
+
+    sha3_256(tx->message, tx->message_len, tx->message_hash);
+    if (tx->transaction.tx_variant != TX_MESSAGE &&
+        tx->transaction.payload_variant == PAYLOAD_SCRIPT) {
+        sha3_256(tx->transaction.payload.script.code.bytes,
+                 tx->transaction.payload.script.code.len,
+                 tx->script_hash);
+    }
+
+    tx->fields_count = transaction_fields_list(&tx->transaction, tx->fields);
+
+    return APTOS_LEDGER_OK;
+}
+
+size_t aptos_ledger_tx_field_count(const aptos_ledger_tx_t *tx) {
+    return tx == NULL ? 0 : tx->fields_count;
+}
+
+int aptos_ledger_tx_field(const aptos_ledger_tx_t *tx,
+                          size_t index,
+                          const char **title,
+                          char *value,
+                          size_t value_len) {
+    if (tx == NULL || value == NULL || index >= tx->fields_count) {
+        return APTOS_LEDGER_ERROR_ARGUMENT;
+    }
+
+    const tx_field_e field = tx->fields[index];
+    if (value_len < transaction_field_len(field)) {
+        return APTOS_LEDGER_ERROR_BUFFER_SIZE;
+    }
+
+    if (title != NULL) {
+        *title = transaction_field_title(field);
+    }
+
+    const uint8_t *hash = NULL;
+    if (field == TX_FIELD_SCRIPT_HASH) {
+        hash = tx->script_hash;
+    } else if (field == TX_FIELD_MESSAGE_HASH) {
+        hash = tx->message_hash;
+    }
+
+    if (!transaction_field_format(&tx->transaction, field, hash, value, value_len)) {
+        return APTOS_LEDGER_ERROR_FORMAT;
+    }
+
+    return APTOS_LEDGER_OK;
+}
+
+int aptos_ledger_signing_message(aptos_ledger_tx_kind_t kind,
+                                 const uint8_t *bcs,
+                                 size_t bcs_len,
+                                 uint8_t *out,
+                                 size_t out_len,
+                                 size_t *written) {
+    const uint8_t *prefix = NULL;
+
+    switch (kind) {
+        case APTOS_LEDGER_RAW_TRANSACTION:
+            prefix = PREFIX_RAW_TX_HASHED;
+            break;
+        case APTOS_LEDGER_RAW_TRANSACTION_WITH_DATA:
+            prefix = PREFIX_RAW_TX_WITH_DATA_HASHED;
+            break;
+        default:
+            return APTOS_LEDGER_ERROR_ARGUMENT;
+    }
+
+    if ((bcs == NULL && bcs_len > 0) || out == NULL || written == NULL) {
+        return APTOS_LEDGER_ERROR_ARGUMENT;
+    }
+
+    *written = 0;
+    if (out_len < TX_HASHED_PREFIX_LEN + bcs_len) {
+        return APTOS_LEDGER_ERROR_BUFFER_SIZE;
+    }
+
+    memcpy(out, prefix, TX_HASHED_PREFIX_LEN);
+    if (bcs_len > 0) {
+        memcpy(out + TX_HASHED_PREFIX_LEN, bcs, bcs_len);
+    }
+    *written = TX_HASHED_PREFIX_LEN + bcs_len;
+
+    return APTOS_LEDGER_OK;
+}
+
+size_t aptos_ledger_max_message_len(void) {
+    return MAX_TRANSACTION_LEN;
+}
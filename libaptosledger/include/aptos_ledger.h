@@ -0,0 +1,164 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint*_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define APTOS_LEDGER_API
+#else
+#define APTOS_LEDGER_API __attribute__((visibility("default")))
+#endif
+
+/**
+ * Version of the C API, incremented on incompatible changes only.
+ */
+#define APTOS_LEDGER_API_VERSION 1
+
+/**
+ * Size of a buffer large enough for any field value, null terminator included.
+ */
+#define APTOS_LEDGER_FIELD_VALUE_LEN 250
+
+/**
+ * Status codes. Negative values above APTOS_LEDGER_ERROR_ARGUMENT are the
+ * statuses of the transaction parser of the device (parser_status_e).
+ */
+#define APTOS_LEDGER_OK                0
+#define APTOS_LEDGER_ERROR_ARGUMENT    -3001  /// NULL pointer, index out of range, ...
+#define APTOS_LEDGER_ERROR_TOO_LONG    -3002  /// larger than the device accepts
+#define APTOS_LEDGER_ERROR_FORMAT      -3003  /// field can't be displayed by the device
+#define APTOS_LEDGER_ERROR_BUFFER_SIZE -3004  /// output buffer too small
+
+/**
+ * Kind of message signed with SIGN_TX.
+ */
+typedef enum {
+    APTOS_LEDGER_RAW_TRANSACTION = 0,           /// BCS of RawTransaction
+    APTOS_LEDGER_RAW_TRANSACTION_WITH_DATA = 1  /// BCS of RawTransactionWithData
+} aptos_ledger_tx_kind_t;
+
+/**
+ * Parsed transaction, opaque. Parsing copies the message so the caller's
+ * buffer can be reused right away; an object can be reused for any number
+ * of parses but must not be shared between threads.
+ */
+typedef struct aptos_ledger_tx aptos_ledger_tx_t;
+
+/**
+ * Allocate transaction object.
+ *
+ * @return pointer to transaction object, NULL if out of memory.
+ *
+ */
+APTOS_LEDGER_API aptos_ledger_tx_t *aptos_ledger_tx_new(void);
+
+/**
+ * Free transaction object.
+ *
+ * @param[in] tx
+ *   Pointer to transaction object, may be NULL.
+ *
+ */
+APTOS_LEDGER_API void aptos_ledger_tx_free(aptos_ledger_tx_t *tx);
+
+/**
+ * Deserialize a signing message (see aptos_ledger_signing_message()) with the
+ * transaction parser of the device.
+ *
+ * Success does not mean that the device signs the message: the length limit
+ * is the one of the library build (see APTOS_LEDGER_TARGET_NANOS), and the
+ * checks made on the device after parsing, such as the refusal of unknown
+ * entry functions with blind signing disabled, are not applied.
+ *
+ * @param[in, out] tx
+ *   Pointer to transaction object.
+ * @param[in]      message
+ *   Pointer to signing message.
+ * @param[in]      message_len
+ *   Length of signing message.
+ *
+ * @return APTOS_LEDGER_OK if the message deserializes, error status otherwise.
+ *
+ */
+APTOS_LEDGER_API int aptos_ledger_tx_parse(aptos_ledger_tx_t *tx,
+                                           const uint8_t *message,
+                                           size_t message_len);
+
+/**
+ * Number of fields displayed by the device for review of the last parsed
+ * transaction.
+ *
+ * @param[in] tx
+ *   Pointer to parsed transaction object.
+ *
+ * @return number of fields, 0 if no transaction was parsed.
+ *
+ */
+APTOS_LEDGER_API size_t aptos_ledger_tx_field_count(const aptos_ledger_tx_t *tx);
+
+/**
+ * Render a field exactly as displayed by the device.
+ *
+ * @param[in]  tx
+ *   Pointer to parsed transaction object.
+ * @param[in]  index
+ *   Index of the field, lower than aptos_ledger_tx_field_count().
+ * @param[out] title
+ *   Pointer to static title of the field, may be NULL.
+ * @param[out] value
+ *   Pointer to output string.
+ * @param[in]  value_len
+ *   Length of output string, APTOS_LEDGER_FIELD_VALUE_LEN is always enough.
+ *
+ * @return APTOS_LEDGER_OK if success, error status otherwise.
+ *
+ */
+APTOS_LEDGER_API int aptos_ledger_tx_field(const aptos_ledger_tx_t *tx,
+                                           size_t index,
+                                           const char **title,
+                                           char *value,
+                                           size_t value_len);
+
+/**
+ * Build the message signed by the device from the BCS serialization of a
+ * transaction, i.e. SHA3-256 of the domain separator followed by the BCS bytes.
+ *
+ * @param[in]  kind
+ *   Kind of transaction serialized in bcs.
+ * @param[in]  bcs
+ *   Pointer to BCS bytes of the transaction.
+ * @param[in]  bcs_len
+ *   Length of BCS bytes.
+ * @param[out] out
+ *   Pointer to output buffer.
+ * @param[in]  out_len
+ *   Length of output buffer.
+ * @param[out] written
+ *   Number of bytes written in output buffer.
+ *
+ * @return APTOS_LEDGER_OK if success, error status otherwise.
+ *
+ */
+APTOS_LEDGER_API int aptos_ledger_signing_message(aptos_ledger_tx_kind_t kind,
+                                                  const uint8_t *bcs,
+                                                  size_t bcs_len,
+                                                  uint8_t *out,
+                                                  size_t out_len,
+                                                  size_t *written);
+
+/**
+ * Maximum length of signing message accepted by the device model the library
+ * is built for (Nano S with APTOS_LEDGER_TARGET_NANOS, other devices otherwise).
+ *
+ * @return maximum length in bytes.
+ *
+ */
+APTOS_LEDGER_API size_t aptos_ledger_max_message_len(void);
+
+#ifdef __cplusplus
+}
+#endif
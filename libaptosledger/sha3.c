@@ -0,0 +1,97 @@
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+#include <string.h>  // memset
+
+#include "sha3.h"
+
+// rate of SHA3-256 in bytes
+#define SHA3_256_RATE 136
+
+#define ROTL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+static const uint64_t KECCAK_RC[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+
+static const unsigned KECCAK_ROTC[24] = {1,  3,  6,  10, 15, 21, 28, 36, 45, 55, 2,  14,
+                                         27, 41, 56, 8,  25, 43, 62, 18, 39, 61, 20, 44};
+
+static const unsigned KECCAK_PILN[24] = {10, 7,  11, 17, 18, 3, 5,  16, 8,  21, 24, 4,
+                                         15, 23, 19, 13, 12, 2, 20, 14, 22, 9,  6,  1};
+
+static void keccak_f1600(uint64_t st[25]) {
+    uint64_t bc[5];
+
+    for (size_t round = 0; round < 24; round++) {
+        // theta
+        for (size_t i = 0; i < 5; i++) {
+            bc[i] = st[i] ^ st[i + 5] ^ st[i + 10] ^ st[i + 15] ^ st[i + 20];
+        }
+        for (size_t i = 0; i < 5; i++) {
+            const uint64_t t = bc[(i + 4) % 5] ^ ROTL64(bc[(i + 1) % 5], 1);
+            for (size_t j = 0; j < 25; j += 5) {
+                st[j + i] ^= t;
+            }
+        }
+        // rho and pi
+        uint64_t t = st[1];
+        for (size_t i = 0; i < 24; i++) {
+            const unsigned j = KECCAK_PILN[i];
+            const uint64_t tmp = st[j];
+            st[j] = ROTL64(t, KECCAK_ROTC[i]);
+            t = tmp;
+        }
+        // chi
+        for (size_t j = 0; j < 25; j += 5) {
+            for (size_t i = 0; i < 5; i++) {
+                bc[i] = st[j + i];
+            }
+            for (size_t i = 0; i < 5; i++) {
+                st[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+            }
+        }
+        // iota
+        st[0] ^= KECCAK_RC[round];
+    }
+}
+
+static void keccak_xor_byte(uint64_t st[25], size_t pos, uint8_t byte) {
+    st[pos / 8] ^= (uint64_t) byte << (8 * (pos % 8));
+}
+
+void sha3_256_init(sha3_256_ctx_t *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void sha3_256_update(sha3_256_ctx_t *ctx, const uint8_t *in, size_t in_len) {
+    for (size_t i = 0; i < in_len; i++) {
+        keccak_xor_byte(ctx->st, ctx->pos++, in[i]);
+        if (ctx->pos == SHA3_256_RATE) {
+            keccak_f1600(ctx->st);
+            ctx->pos = 0;
+        }
+    }
+}
+
+void sha3_256_final(sha3_256_ctx_t *ctx, uint8_t out[SHA3_256_LEN]) {
+    // SHA3 domain padding
+    keccak_xor_byte(ctx->st, ctx->pos, 0x06);
+    keccak_xor_byte(ctx->st, SHA3_256_RATE - 1, 0x80);
+    keccak_f1600(ctx->st);
+
+    for (size_t i = 0; i < SHA3_256_LEN; i++) {
+        out[i] = (uint8_t) (ctx->st[i / 8] >> (8 * (i % 8)));
+    }
+}
+
+void sha3_256(const uint8_t *in, size_t in_len, uint8_t out[SHA3_256_LEN]) {
+    sha3_256_ctx_t ctx;
+
+    sha3_256_init(&ctx);
+    sha3_256_update(&ctx, in, in_len);
+    sha3_256_final(&ctx, out);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint*_t
+
+#define SHA3_256_LEN 32
+
+/**
+ * Incremental SHA3-256 state, no allocation involved.
+ */
+typedef struct {
+    uint64_t st[25];  /// Keccak-f[1600] state
+    size_t pos;       /// offset of the next absorbed byte in the rate
+} sha3_256_ctx_t;
+
+/**
+ * Reset SHA3-256 state.
+ *
+ * @param[out] ctx
+ *   Pointer to SHA3-256 state.
+ *
+ */
+void sha3_256_init(sha3_256_ctx_t *ctx);
+
+/**
+ * Absorb bytes into SHA3-256 state.
+ *
+ * @param[in,out] ctx
+ *   Pointer to SHA3-256 state.
+ * @param[in]     in
+ *   Pointer to input byte buffer.
+ * @param[in]     in_len
+ *   Length of input byte buffer.
+ *
+ */
+void sha3_256_update(sha3_256_ctx_t *ctx, const uint8_t *in, size_t in_len);
+
+/**
+ * Pad SHA3-256 state and squeeze the hash.
+ *
+ * @param[in,out] ctx
+ *   Pointer to SHA3-256 state, to reset before reuse.
+ * @param[out]    out
+ *   Pointer to SHA3_256_LEN bytes of hash.
+ *
+ */
+void sha3_256_final(sha3_256_ctx_t *ctx, uint8_t out[SHA3_256_LEN]);
+
+/**
+ * SHA3-256 of a byte buffer (FIPS 202), host counterpart of cx_sha3_*().
+ *
+ * @param[in]  in
+ *   Pointer to input byte buffer.
+ * @param[in]  in_len
+ *   Length of input byte buffer.
+ * @param[out] out
+ *   Pointer to SHA3_256_LEN bytes of hash.
+ *
+ */
+void sha3_256(const uint8_t *in, size_t in_len, uint8_t out[SHA3_256_LEN]);
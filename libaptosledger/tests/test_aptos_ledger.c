@@ -0,0 +1,163 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "aptos_ledger.h"
+#include "sha3.h"
+
+// clang-format off
+static const uint8_t coin_transfer_tx[] = {
+    0xb5, 0xe9, 0x7d, 0xb0, 0x7f, 0xa0, 0xbd, 0x0e,
+    0x55, 0x98, 0xaa, 0x36, 0x43, 0xa9, 0xbc, 0x6f,
+    0x66, 0x93, 0xbd, 0xdc, 0x1a, 0x9f, 0xec, 0x9e,
+    0x67, 0x4a, 0x46, 0x1e, 0xaa, 0x00, 0xb1, 0x93,
+    0x86, 0xbf, 0x1b, 0x58, 0x94, 0x2d, 0x9b, 0xf1,
+    0x24, 0x75, 0xa4, 0x1f, 0x2f, 0x43, 0xb9, 0x70,
+    0x87, 0xdd, 0x91, 0x93, 0x7f, 0x40, 0x1e, 0xec,
+    0x08, 0x31, 0x11, 0x68, 0xa9, 0xba, 0xc2, 0xf3,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x04, 0x63, 0x6f, 0x69, 0x6e, 0x08, 0x74,
+    0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x01,
+    0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x0a, 0x61, 0x70, 0x74, 0x6f, 0x73, 0x5f,
+    0x63, 0x6f, 0x69, 0x6e, 0x09, 0x41, 0x70, 0x74,
+    0x6f, 0x73, 0x43, 0x6f, 0x69, 0x6e, 0x00, 0x02,
+    0x20, 0xa7, 0x67, 0x6a, 0x00, 0x3b, 0x6f, 0xb4,
+    0x74, 0x48, 0xb7, 0x9b, 0x8d, 0x68, 0xd2, 0x88,
+    0x46, 0xb9, 0x29, 0x32, 0x94, 0x1c, 0x92, 0xbe,
+    0xec, 0xd1, 0x9f, 0x1b, 0xee, 0x6a, 0x68, 0x52,
+    0x08, 0x08, 0xcd, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x13, 0x84, 0x65, 0x63, 0x00, 0x00,
+    0x00, 0x00, 0x24
+};
+// clang-format on
+
+static void test_sha3_256(void **state) {
+    (void) state;
+
+    uint8_t hash[SHA3_256_LEN] = {0};
+    // clang-format off
+    static const uint8_t empty_hash[] = {
+        0xa7, 0xff, 0xc6, 0xf8, 0xbf, 0x1e, 0xd7, 0x66,
+        0x51, 0xc1, 0x47, 0x56, 0xa0, 0x61, 0xd6, 0x62,
+        0xf5, 0x80, 0xff, 0x4d, 0xe4, 0x3b, 0x49, 0xfa,
+        0x82, 0xd8, 0x0a, 0x4b, 0x80, 0xf8, 0x43, 0x4a
+    };
+    // clang-format on
+    sha3_256(NULL, 0, hash);
+    assert_memory_equal(hash, empty_hash, sizeof(hash));
+
+    // hashed prefix of RawTransaction is SHA3-256 of its domain separator
+    const char salt[] = "APTOS::RawTransaction";
+    sha3_256((const uint8_t *) salt, strlen(salt), hash);
+    assert_memory_equal(hash, coin_transfer_tx, sizeof(hash));
+
+    // input longer than the rate of SHA3-256
+    uint8_t block[200];
+    memset(block, 0x61, sizeof(block));
+    uint8_t other[SHA3_256_LEN] = {0};
+    sha3_256(block, 136, hash);
+    sha3_256(block, 137, other);
+    assert_memory_not_equal(hash, other, sizeof(hash));
+}
+
+static void test_signing_message(void **state) {
+    (void) state;
+
+    uint8_t message[sizeof(coin_transfer_tx)] = {0};
+    size_t written = 0;
+    const uint8_t *bcs = coin_transfer_tx + 32;
+    const size_t bcs_len = sizeof(coin_transfer_tx) - 32;
+
+    assert_int_equal(aptos_ledger_signing_message(APTOS_LEDGER_RAW_TRANSACTION,
+                                                  bcs,
+                                                  bcs_len,
+                                                  message,
+                                                  sizeof(message),
+                                                  &written),
+                     APTOS_LEDGER_OK);
+    assert_int_equal(written, sizeof(coin_transfer_tx));
+    assert_memory_equal(message, coin_transfer_tx, sizeof(coin_transfer_tx));
+
+    assert_int_equal(aptos_ledger_signing_message(APTOS_LEDGER_RAW_TRANSACTION,
+                                                  bcs,
+                                                  bcs_len,
+                                                  message,
+                                                  sizeof(message) - 1,
+                                                  &written),
+                     APTOS_LEDGER_ERROR_BUFFER_SIZE);
+    assert_int_equal(written, 0);
+}
+
+static void test_tx_fields(void **state) {
+    (void) state;
+
+    static const char *expected[][2] = {
+        {"Function", "0x01::coin::transfer"},
+        {"Coin Type", "0x00..01::aptos_coin::AptosCoin"},
+        {"Receiver", "0xA7676A003B6FB47448B79B8D68D28846B92932941C92BEECD19F1BEE6A685208"},
+        {"Amount", "0.00000717"},
+        {"Gas Fee", "APT 0.02000000"},
+        {"Message Hash", "0xA1288FC5...5862C116"},
+    };
+    aptos_ledger_tx_t *tx = aptos_ledger_tx_new();
+    char value[APTOS_LEDGER_FIELD_VALUE_LEN] = {0};
+    const char *title = NULL;
+
+    assert_non_null(tx);
+    assert_int_equal(aptos_ledger_tx_field_count(tx), 0);
+    assert_int_equal(aptos_ledger_tx_parse(tx, coin_transfer_tx, sizeof(coin_transfer_tx)),
+                     APTOS_LEDGER_OK);
+    assert_int_equal(aptos_ledger_tx_field_count(tx), sizeof(expected) / sizeof(expected[0]));
+    for (size_t i = 0; i < aptos_ledger_tx_field_count(tx); i++) {
+        assert_int_equal(aptos_ledger_tx_field(tx, i, &title, value, sizeof(value)),
+                         APTOS_LEDGER_OK);
+        assert_string_equal(title, expected[i][0]);
+        assert_string_equal(value, expected[i][1]);
+    }
+    assert_int_equal(aptos_ledger_tx_field(tx, 6, &title, value, sizeof(value)),
+                     APTOS_LEDGER_ERROR_ARGUMENT);
+    assert_int_equal(aptos_ledger_tx_field(tx, 0, &title, value, 10),
+                     APTOS_LEDGER_ERROR_BUFFER_SIZE);
+
+    // truncated transaction is rejected like on the device
+    assert_true(aptos_ledger_tx_parse(tx, coin_transfer_tx, sizeof(coin_transfer_tx) - 1) < 0);
+    assert_int_equal(aptos_ledger_tx_field_count(tx), 0);
+
+    uint8_t too_long[8192] = {0};
+    assert_int_equal(aptos_ledger_tx_parse(tx, too_long, aptos_ledger_max_message_len() + 1),
+                     APTOS_LEDGER_ERROR_TOO_LONG);
+
+    // anything without hashed prefix is an ASCII message
+    const char msg[] = "Hello, Aptos!";
+    assert_int_equal(aptos_ledger_tx_parse(tx, (const uint8_t *) msg, strlen(msg)),
+                     APTOS_LEDGER_OK);
+    assert_int_equal(aptos_ledger_tx_field_count(tx), 1);
+    assert_int_equal(aptos_ledger_tx_field(tx, 0, &title, value, sizeof(value)), APTOS_LEDGER_OK);
+    assert_string_equal(title, "Message");
+    assert_string_equal(value, msg);
+
+    aptos_ledger_tx_free(tx);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_sha3_256),
+                                       cmocka_unit_test(test_signing_message),
+                                       cmocka_unit_test(test_tx_fields)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
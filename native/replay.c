@@ -0,0 +1,357 @@
+/*****************************************************************************
+ *   Replay of APDU files through the application built for the host.
+ *
+ *   The real main loop, dispatcher and handlers run against the stubs of
+ *   native/sdk: io_exchange() below feeds the commands of the file and
+ *   collects the responses, and the approve (or reject) step of every flow
+ *   displayed while waiting for the user is pressed right away.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <stdio.h>    // FILE, fopen, fprintf, getline
+#include <stdlib.h>   // strtoul, strtoull, malloc, realloc, free
+#include <string.h>   // memcpy, strcmp, strstr, strlen
+#include <setjmp.h>   // jmp_buf, setjmp, longjmp
+#include <time.h>     // clock_gettime
+
+#include "os.h"
+#include "cx.h"
+#include "ux.h"
+
+#include "types.h"
+#include "globals.h"
+
+/**
+ * Entry point of src/main.c, renamed at build time.
+ */
+int app_boot(void);
+
+typedef struct {
+    uint8_t *command;       /// APDU command
+    size_t command_len;     /// length of APDU command
+    uint8_t *expected;      /// expected response, NULL if not checked
+    size_t expected_len;    /// length of expected response
+    unsigned int line;      /// line in replay file
+} replay_entry_t;
+
+static struct {
+    replay_entry_t *entries;  /// commands of the replay file
+    size_t count;             /// number of commands
+    size_t next;              /// index of next command to send
+    bool answered;            /// whether the last sent command got its response
+    uint64_t round;           /// index of current pass over the file
+    uint64_t repeat;          /// number of passes over the file
+    uint64_t commands;        /// number of commands sent
+    uint64_t failures;        /// missing, duplicate or unexpected responses
+    bool quiet;               /// only print failures
+    bool reject;              /// press reject instead of approve
+    jmp_buf end;              /// restored once every pass is done
+} G_replay;
+
+static void print_hex(const char *prefix, const uint8_t *bytes, size_t len) {
+    printf("%s", prefix);
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", bytes[i]);
+    }
+    printf("\n");
+}
+
+static void replay_failure(const char *reason) {
+    const replay_entry_t *entry = &G_replay.entries[G_replay.next - 1];
+
+    G_replay.failures++;
+    fprintf(stderr, "line %u: %s\n", entry->line, reason);
+}
+
+static void replay_response(const uint8_t *response, size_t response_len) {
+    const replay_entry_t *entry = &G_replay.entries[G_replay.next - 1];
+
+    if (!G_replay.quiet) {
+        print_hex("<= ", response, response_len);
+    }
+
+    if (G_replay.answered) {
+        replay_failure("more than one response");
+        return;
+    }
+    G_replay.answered = true;
+
+    if (entry->expected != NULL &&
+        (entry->expected_len != response_len ||
+         memcmp(entry->expected, response, response_len) != 0)) {
+        replay_failure("unexpected response");
+        if (G_replay.quiet) {
+            print_hex("<= ", response, response_len);
+        }
+    }
+}
+
+static size_t replay_command() {
+    const replay_entry_t *entry = NULL;
+
+    if (G_replay.commands > 0 && !G_replay.answered) {
+        replay_failure("no response");
+    }
+
+    if (G_replay.next == G_replay.count) {
+        if (++G_replay.round == G_replay.repeat) {
+            longjmp(G_replay.end, 1);
+        }
+        G_replay.next = 0;
+    }
+
+    entry = &G_replay.entries[G_replay.next++];
+    memcpy(G_io_apdu_buffer, entry->command, entry->command_len);
+    G_replay.answered = false;
+    G_replay.commands++;
+
+    if (!G_replay.quiet) {
+        print_hex("=> ", entry->command, entry->command_len);
+    }
+
+    return entry->command_len;
+}
+
+static bool step_name_ends_with(const ux_flow_step_t *step, const char *suffix) {
+    const size_t name_len = strlen(step->name);
+    const size_t suffix_len = strlen(suffix);
+
+    return name_len >= suffix_len && strcmp(step->name + name_len - suffix_len, suffix) == 0;
+}
+
+/**
+ * Scroll through the displayed flow, printing the title and text of its
+ * screens, and press its approve or reject step.
+ */
+static void replay_press() {
+    const ux_flow_step_t *const *flow = native_ux_current_flow();
+    const char *suffix = G_replay.reject ? "_reject_step" : "_approve_step";
+
+    for (size_t i = 0; flow != NULL && flow[i] != FLOW_END_STEP; i++) {
+        const ux_flow_step_t *step = flow[i];
+
+        if (step == FLOW_LOOP || step == FLOW_BARRIER) {
+            continue;
+        }
+        if (step->init != NULL) {
+            step->init(0);
+        }
+        if (!G_replay.quiet && step->params->title != NULL) {
+            printf("   %s: %s\n", step->params->title, step->params->text);
+        }
+        if (step->validate != NULL && step_name_ends_with(step, suffix)) {
+            step->validate();
+            return;
+        }
+    }
+
+    replay_failure("waiting for the user without approve and reject steps");
+}
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len) {
+    // like the SDK, tx_len is ignored when the response is asynchronous
+    if (tx_len > 0 && !(channel_and_flags & IO_ASYNCH_REPLY)) {
+        replay_response(G_io_apdu_buffer, tx_len);
+    }
+
+    if (channel_and_flags & IO_RETURN_AFTER_TX) {
+        return 0;
+    }
+
+    if (channel_and_flags & IO_ASYNCH_REPLY) {
+        // the response is sent from the button callback
+        replay_press();
+    }
+
+    return (unsigned short) replay_command();
+}
+
+/**
+ * Parse hexadecimal string, spaces are skipped.
+ *
+ * @return length of bytes, -1 if not hexadecimal or too long.
+ */
+static int parse_hex(const char *hex, uint8_t *out, size_t out_len) {
+    size_t len = 0;
+    int high = -1;
+
+    for (; *hex != '\0'; hex++) {
+        int nibble = -1;
+
+        if (*hex >= '0' && *hex <= '9') {
+            nibble = *hex - '0';
+        } else if (*hex >= 'a' && *hex <= 'f') {
+            nibble = *hex - 'a' + 10;
+        } else if (*hex >= 'A' && *hex <= 'F') {
+            nibble = *hex - 'A' + 10;
+        } else if (*hex == ' ' || *hex == '\t' || *hex == '\r' || *hex == '\n') {
+            continue;
+        } else {
+            return -1;
+        }
+
+        if (high < 0) {
+            high = nibble;
+        } else {
+            if (len == out_len) {
+                return -1;
+            }
+            out[len++] = (uint8_t) (high << 4 | nibble);
+            high = -1;
+        }
+    }
+
+    return (high < 0) ? (int) len : -1;
+}
+
+static uint8_t *copy_bytes(const uint8_t *bytes, size_t len) {
+    uint8_t *copy = malloc(len);
+
+    if (copy != NULL) {
+        memcpy(copy, bytes, len);
+    }
+
+    return copy;
+}
+
+/**
+ * Load replay file: one APDU command in hexadecimal per line, optionally
+ * followed by "=>" and the expected response. Empty lines and lines
+ * starting with '#' are skipped.
+ */
+static bool replay_load(const char *path) {
+    uint8_t bytes[IO_APDU_BUFFER_SIZE];
+    char *line = NULL;
+    size_t line_size = 0;
+    unsigned int line_number = 0;
+    bool ok = true;
+    FILE *f = fopen(path, "r");
+
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+
+    while (ok && getline(&line, &line_size, f) >= 0) {
+        replay_entry_t entry = {0};
+        char *arrow = strstr(line, "=>");
+        const char *p = line;
+        int len = 0;
+
+        line_number++;
+        while (*p == ' ' || *p == '\t') {
+            p++;
+        }
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') {
+            continue;
+        }
+
+        if (arrow != NULL) {
+            *arrow = '\0';
+        }
+        entry.line = line_number;
+        if ((len = parse_hex(line, bytes, sizeof(bytes))) < 5) {
+            fprintf(stderr, "%s:%u: invalid APDU command\n", path, line_number);
+            ok = false;
+            break;
+        }
+        entry.command_len = (size_t) len;
+        entry.command = copy_bytes(bytes, entry.command_len);
+
+        if (arrow != NULL) {
+            if ((len = parse_hex(arrow + 2, bytes, sizeof(bytes))) < 2) {
+                fprintf(stderr, "%s:%u: invalid expected response\n", path, line_number);
+                ok = false;
+                break;
+            }
+            entry.expected_len = (size_t) len;
+            entry.expected = copy_bytes(bytes, entry.expected_len);
+        }
+
+        G_replay.entries =
+            realloc(G_replay.entries, (G_replay.count + 1) * sizeof(*G_replay.entries));
+        G_replay.entries[G_replay.count++] = entry;
+    }
+
+    free(line);
+    fclose(f);
+
+    if (ok && G_replay.count == 0) {
+        fprintf(stderr, "%s: no APDU command\n", path);
+        ok = false;
+    }
+
+    return ok;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [--repeat N] [--quiet] [--reject] [--blind-signing] [--expert-mode] "
+            "[--throw-on-hash N] FILE\n",
+            name);
+}
+
+int main(int argc, char *argv[]) {
+    internal_storage_t storage = {.initialized = 0x01, .version = SETTINGS_VERSION};
+    const char *path = NULL;
+    struct timespec start;
+    struct timespec stop;
+    double elapsed = 0;
+
+    G_replay.repeat = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            G_replay.repeat = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            G_replay.quiet = true;
+        } else if (strcmp(argv[i], "--reject") == 0) {
+            G_replay.reject = true;
+        } else if (strcmp(argv[i], "--blind-signing") == 0) {
+            storage.blind_signing = 0x01;
+        } else if (strcmp(argv[i], "--expert-mode") == 0) {
+            storage.expert_mode = 0x01;
+        } else if (strcmp(argv[i], "--throw-on-hash") == 0 && i + 1 < argc) {
+            native_cx_hash_throw_at = strtoul(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-' && path == NULL) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (path == NULL || G_replay.repeat == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (!replay_load(path)) {
+        return 2;
+    }
+
+    // settings as if already toggled from the menu
+    nvm_write((void *) &N_storage_real, &storage, sizeof(storage));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (setjmp(G_replay.end) == 0) {
+        app_boot();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    if (!G_replay.answered) {
+        replay_failure("no response");
+    }
+
+    elapsed = (double) (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr,
+            "%llu commands in %.3f s (%.0f commands/s), %llu failures\n",
+            (unsigned long long) G_replay.commands,
+            elapsed,
+            elapsed > 0 ? G_replay.commands / elapsed : 0,
+            (unsigned long long) G_replay.failures);
+
+    return G_replay.failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,320 @@
+/*****************************************************************************
+ *   Native (host) stand-in of the BOLOS SDK cryptography: SHA3-256 from
+ *   libaptosledger, Ed25519, HMAC-SHA512 and PBKDF2 from OpenSSL.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <string.h>   // memcpy, memset, strlen
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include "os.h"
+#include "cx.h"
+
+/**
+ * Mnemonic of the default seed of Speculos, so that replayed responses
+ * match the ones of the emulator.
+ */
+#define NATIVE_MNEMONIC                                                       \
+    "glory promote mansion idle axis finger extra february uncover one trip " \
+    "resource lawn turtle enact monster seven myth punch hobby comfort wild " \
+    "raise skin"
+
+#define HARDENED_OFFSET 0x80000000u
+
+unsigned int native_cx_hash_throw_at;
+
+/**
+ * Number of cx_hash() calls so far.
+ */
+static unsigned int s_cx_hash_calls;
+
+int cx_sha3_init(cx_sha3_t *hash, size_t size) {
+    if (size != 256) {
+        THROW(INVALID_PARAMETER);
+    }
+    hash->header.algo = CX_SHA3;
+    sha3_256_init(&hash->ctx);
+
+    return 0;
+}
+
+int cx_hash(cx_hash_t *hash,
+            int mode,
+            const uint8_t *in,
+            size_t len,
+            uint8_t *out,
+            size_t out_len) {
+    cx_sha3_t *sha3 = (cx_sha3_t *) hash;
+
+    if (++s_cx_hash_calls == native_cx_hash_throw_at) {
+        THROW(EXCEPTION);
+    }
+    if (hash->algo != CX_SHA3) {
+        THROW(INVALID_PARAMETER);
+    }
+    sha3_256_update(&sha3->ctx, in, len);
+    if (mode & CX_LAST) {
+        if (out_len < SHA3_256_LEN) {
+            THROW(INVALID_PARAMETER);
+        }
+        sha3_256_final(&sha3->ctx, out);
+        sha3_256_init(&sha3->ctx);
+
+        return SHA3_256_LEN;
+    }
+
+    return 0;
+}
+
+int cx_hash_update(cx_hash_t *hash, const uint8_t *in, size_t len) {
+    return cx_hash(hash, 0, in, len, NULL, 0);
+}
+
+int cx_hash_final(cx_hash_t *hash, uint8_t *out) {
+    return cx_hash(hash, CX_LAST, NULL, 0, out, SHA3_256_LEN);
+}
+
+int cx_ecfp_init_private_key(cx_curve_t curve,
+                             const uint8_t *raw_key,
+                             size_t key_len,
+                             cx_ecfp_private_key_t *private_key) {
+    if (curve != CX_CURVE_Ed25519 || key_len != sizeof(private_key->d)) {
+        THROW(INVALID_PARAMETER);
+    }
+    private_key->curve = curve;
+    private_key->d_len = key_len;
+    memcpy(private_key->d, raw_key, key_len);
+
+    return (int) key_len;
+}
+
+static EVP_PKEY *native_ed25519_key(const cx_ecfp_private_key_t *private_key) {
+    EVP_PKEY *pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519,
+                                                  NULL,
+                                                  private_key->d,
+                                                  private_key->d_len);
+
+    if (pkey == NULL) {
+        THROW(EXCEPTION);
+    }
+
+    return pkey;
+}
+
+int cx_ecfp_generate_pair(cx_curve_t curve,
+                          cx_ecfp_public_key_t *public_key,
+                          cx_ecfp_private_key_t *private_key,
+                          int keep_private) {
+    uint8_t compressed[32] = {0};
+    size_t compressed_len = sizeof(compressed);
+    EVP_PKEY *pkey = NULL;
+
+    if (curve != CX_CURVE_Ed25519 || !keep_private) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    pkey = native_ed25519_key(private_key);
+    if (EVP_PKEY_get_raw_public_key(pkey, compressed, &compressed_len) != 1) {
+        EVP_PKEY_free(pkey);
+        THROW(EXCEPTION);
+    }
+    EVP_PKEY_free(pkey);
+
+    // Only y and the parity of x are known from the encoded point, which is
+    // all crypto_init_public_key() reads back: W[33..64] is big-endian y and
+    // the low bit of W[32] is the low bit of x.
+    memset(public_key, 0, sizeof(*public_key));
+    public_key->curve = curve;
+    public_key->W_len = sizeof(public_key->W);
+    public_key->W[0] = 0x04;
+    public_key->W[32] = compressed[31] >> 7;
+    for (size_t i = 0; i < 32; i++) {
+        public_key->W[64 - i] = compressed[i];
+    }
+    public_key->W[33] &= 0x7F;
+
+    return 0;
+}
+
+int cx_eddsa_sign(const cx_ecfp_private_key_t *private_key,
+                  int mode,
+                  cx_md_t hash_id,
+                  const uint8_t *hash,
+                  size_t hash_len,
+                  const uint8_t *ctx,
+                  size_t ctx_len,
+                  uint8_t *sig,
+                  size_t sig_len,
+                  unsigned int *info) {
+    EVP_MD_CTX *md_ctx = NULL;
+    EVP_PKEY *pkey = NULL;
+    size_t len = sig_len;
+    int ok = 0;
+
+    (void) mode;
+    (void) ctx;
+    (void) ctx_len;
+    (void) info;
+
+    if (hash_id != CX_SHA512 || sig_len < 64) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    pkey = native_ed25519_key(private_key);
+    md_ctx = EVP_MD_CTX_new();
+    ok = md_ctx != NULL &&                                           //
+         EVP_DigestSignInit(md_ctx, NULL, NULL, NULL, pkey) == 1 &&  //
+         EVP_DigestSign(md_ctx, sig, &len, hash, hash_len) == 1;
+    EVP_MD_CTX_free(md_ctx);
+    EVP_PKEY_free(pkey);
+
+    if (!ok) {
+        THROW(EXCEPTION);
+    }
+
+    return (int) len;
+}
+
+int cx_ecfp_init_public_key(cx_curve_t curve,
+                            const uint8_t *raw_key,
+                            size_t key_len,
+                            cx_ecfp_public_key_t *public_key) {
+    if (curve != CX_CURVE_Ed25519 || key_len != sizeof(public_key->W)) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    memset(public_key, 0, sizeof(*public_key));
+    public_key->curve = curve;
+    public_key->W_len = key_len;
+    memcpy(public_key->W, raw_key, key_len);
+
+    return 0;
+}
+
+void cx_edwards_decompress_point(cx_curve_t curve, uint8_t *P, size_t P_len) {
+    uint8_t y[32] = {0};
+
+    if (curve != CX_CURVE_Ed25519 || P_len != 65 || P[0] != 0x02) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    // x is not computed, only its parity is kept like cx_ecfp_generate_pair()
+    memcpy(y, P + 1, sizeof(y));
+    memset(P, 0, P_len);
+    P[0] = 0x04;
+    P[32] = y[0] >> 7;
+    y[0] &= 0x7F;
+    memcpy(P + 33, y, sizeof(y));
+}
+
+int cx_eddsa_verify(const cx_ecfp_public_key_t *public_key,
+                    int mode,
+                    cx_md_t hash_id,
+                    const uint8_t *hash,
+                    size_t hash_len,
+                    const uint8_t *ctx,
+                    size_t ctx_len,
+                    const uint8_t *sig,
+                    size_t sig_len) {
+    uint8_t compressed[32] = {0};
+    EVP_MD_CTX *md_ctx = NULL;
+    EVP_PKEY *pkey = NULL;
+    int ok = 0;
+
+    (void) mode;
+    (void) ctx;
+    (void) ctx_len;
+
+    if (hash_id != CX_SHA512 || public_key->curve != CX_CURVE_Ed25519) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    for (size_t i = 0; i < 32; i++) {
+        compressed[i] = public_key->W[64 - i];
+    }
+    compressed[31] |= (public_key->W[32] & 1) << 7;
+
+    pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, NULL, compressed, sizeof(compressed));
+    md_ctx = EVP_MD_CTX_new();
+    ok = pkey != NULL && md_ctx != NULL &&                             //
+         EVP_DigestVerifyInit(md_ctx, NULL, NULL, NULL, pkey) == 1 &&  //
+         EVP_DigestVerify(md_ctx, sig, sig_len, hash, hash_len) == 1;
+    EVP_MD_CTX_free(md_ctx);
+    EVP_PKEY_free(pkey);
+
+    return ok;
+}
+
+/**
+ * BIP39 seed of NATIVE_MNEMONIC with an empty passphrase, computed once.
+ */
+static const uint8_t *native_seed() {
+    static uint8_t seed[64];
+    static bool ready = false;
+
+    if (!ready) {
+        static const char mnemonic[] = NATIVE_MNEMONIC;
+
+        if (PKCS5_PBKDF2_HMAC(mnemonic,
+                              sizeof(mnemonic) - 1,
+                              (const unsigned char *) "mnemonic",
+                              8,
+                              2048,
+                              EVP_sha512(),
+                              sizeof(seed),
+                              seed) != 1) {
+            THROW(EXCEPTION);
+        }
+        ready = true;
+    }
+
+    return seed;
+}
+
+void os_perso_derive_node_bip32_seed_key(unsigned int mode,
+                                         unsigned int curve,
+                                         const unsigned int *path,
+                                         unsigned int path_len,
+                                         unsigned char *private_key,
+                                         unsigned char *chain,
+                                         unsigned char *seed_key,
+                                         unsigned int seed_key_len) {
+    uint8_t node[64];
+    uint8_t data[1 + 32 + 4];
+    unsigned int node_len = sizeof(node);
+
+    // SLIP-0010 for Ed25519, where only hardened derivation exists
+    if (mode != HDW_ED25519_SLIP10 || curve != CX_CURVE_Ed25519) {
+        THROW(INVALID_PARAMETER);
+    }
+
+    if (HMAC(EVP_sha512(), seed_key, (int) seed_key_len, native_seed(), 64, node, &node_len) ==
+        NULL) {
+        THROW(EXCEPTION);
+    }
+
+    for (unsigned int i = 0; i < path_len; i++) {
+        if (!(path[i] & HARDENED_OFFSET)) {
+            THROW(INVALID_PARAMETER);
+        }
+        data[0] = 0x00;
+        memcpy(data + 1, node, 32);
+        data[33] = (uint8_t) (path[i] >> 24);
+        data[34] = (uint8_t) (path[i] >> 16);
+        data[35] = (uint8_t) (path[i] >> 8);
+        data[36] = (uint8_t) path[i];
+        if (HMAC(EVP_sha512(), node + 32, 32, data, sizeof(data), node, &node_len) == NULL) {
+            THROW(EXCEPTION);
+        }
+    }
+
+    memcpy(private_key, node, 32);
+    if (chain != NULL) {
+        memcpy(chain, node + 32, 32);
+    }
+    explicit_bzero(node, sizeof(node));
+    explicit_bzero(data, sizeof(data));
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ *   Native (host) stand-in of the BOLOS SDK cx.h, only what the app uses.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+
+#include "sha3.h"
+
+typedef enum { CX_CURVE_Ed25519 = 0x41 } cx_curve_t;
+
+typedef enum { CX_NONE = 0, CX_SHA512 = 5, CX_SHA3 = 6 } cx_md_t;
+
+#define CX_LAST (1 << 0)
+
+typedef struct {
+    cx_curve_t curve;
+    size_t d_len;
+    uint8_t d[32];
+} cx_ecfp_private_key_t;
+
+typedef struct {
+    cx_curve_t curve;
+    size_t W_len;
+    uint8_t W[65];  /// 0x04 || x (big-endian) || y (big-endian)
+} cx_ecfp_public_key_t;
+
+typedef struct {
+    cx_md_t algo;
+} cx_hash_t;
+
+typedef struct {
+    cx_hash_t header;
+    sha3_256_ctx_t ctx;
+} cx_sha3_t;
+
+/**
+ * Index (from 1) of the cx_hash() call which throws EXCEPTION, 0 to never
+ * throw. Set by the replay to check how exceptions are reported.
+ */
+extern unsigned int native_cx_hash_throw_at;
+
+int cx_sha3_init(cx_sha3_t *hash, size_t size);
+int cx_hash(cx_hash_t *hash,
+            int mode,
+            const uint8_t *in,
+            size_t len,
+            uint8_t *out,
+            size_t out_len);
+int cx_hash_update(cx_hash_t *hash, const uint8_t *in, size_t len);
+int cx_hash_final(cx_hash_t *hash, uint8_t *out);
+
+int cx_ecfp_init_private_key(cx_curve_t curve,
+                             const uint8_t *raw_key,
+                             size_t key_len,
+                             cx_ecfp_private_key_t *private_key);
+int cx_ecfp_generate_pair(cx_curve_t curve,
+                          cx_ecfp_public_key_t *public_key,
+                          cx_ecfp_private_key_t *private_key,
+                          int keep_private);
+int cx_eddsa_sign(const cx_ecfp_private_key_t *private_key,
+                  int mode,
+                  cx_md_t hash_id,
+                  const uint8_t *hash,
+                  size_t hash_len,
+                  const uint8_t *ctx,
+                  size_t ctx_len,
+                  uint8_t *sig,
+                  size_t sig_len,
+                  unsigned int *info);
+int cx_ecfp_init_public_key(cx_curve_t curve,
+                            const uint8_t *raw_key,
+                            size_t key_len,
+                            cx_ecfp_public_key_t *public_key);
+void cx_edwards_decompress_point(cx_curve_t curve, uint8_t *P, size_t P_len);
+int cx_eddsa_verify(const cx_ecfp_public_key_t *public_key,
+                    int mode,
+                    cx_md_t hash_id,
+                    const uint8_t *hash,
+                    size_t hash_len,
+                    const uint8_t *ctx,
+                    size_t ctx_len,
+                    const uint8_t *sig,
+                    size_t sig_len);
@@ -0,0 +1,17 @@
+/*****************************************************************************
+ *   Native (host) stand-in of the glyphs generated from glyphs/ at build time.
+ *****************************************************************************/
+
+#pragma once
+
+#include "ux.h"
+
+extern const bagl_icon_details_t C_aptos_logo;
+extern const bagl_icon_details_t C_icon_back;
+extern const bagl_icon_details_t C_icon_certificate;
+extern const bagl_icon_details_t C_icon_coggle;
+extern const bagl_icon_details_t C_icon_crossmark;
+extern const bagl_icon_details_t C_icon_dashboard_x;
+extern const bagl_icon_details_t C_icon_eye;
+extern const bagl_icon_details_t C_icon_validate_14;
+extern const bagl_icon_details_t C_icon_warning;
@@ -0,0 +1,192 @@
+/*****************************************************************************
+ *   Native (host) stand-in of the BOLOS SDK system calls.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdarg.h>   // va_list, va_start, va_arg, va_end
+#include <stdlib.h>   // abort, exit
+#include <string.h>   // memcpy, strlen
+#include <sys/mman.h>  // mprotect
+#include <unistd.h>   // sysconf
+
+#include "os.h"
+#include "os_io_seproxyhal.h"
+
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+io_apdu_media_t G_io_apdu_media = IO_APDU_MEDIA_USB_HID;
+
+static try_context_t *G_try_last_open_context = NULL;
+
+try_context_t *try_context_get() {
+    return G_try_last_open_context;
+}
+
+try_context_t *try_context_set(try_context_t *context) {
+    try_context_t *previous = G_try_last_open_context;
+
+    G_try_last_open_context = context;
+
+    return previous;
+}
+
+void os_longjmp(unsigned int exception) {
+    if (G_try_last_open_context == NULL) {
+        fprintf(stderr, "uncaught exception 0x%04X\n", exception);
+        abort();
+    }
+
+    longjmp(G_try_last_open_context->jmp_buf, exception);
+}
+
+/**
+ * Append string to str as snprintf() does, keeping it NUL terminated.
+ */
+static void append(char *str, size_t str_size, size_t *offset, const char *src, size_t src_len) {
+    for (size_t i = 0; i < src_len; i++, (*offset)++) {
+        if (*offset + 1 < str_size) {
+            str[*offset] = src[i];
+        }
+    }
+}
+
+int native_snprintf(char *str, size_t str_size, const char *format, ...) {
+    static const char hex_upper[] = "0123456789ABCDEF";
+    static const char hex_lower[] = "0123456789abcdef";
+    size_t offset = 0;
+    va_list ap;
+
+    va_start(ap, format);
+    for (const char *p = format; *p != '\0'; p++) {
+        char tmp[32];
+        int precision = -1;
+
+        if (*p != '%') {
+            append(str, str_size, &offset, p, 1);
+            continue;
+        }
+        p++;
+        if (p[0] == '.' && p[1] == '*') {
+            precision = va_arg(ap, int);
+            p += 2;
+        }
+        switch (*p) {
+            case 'H':
+            case 'h': {
+                const uint8_t *bytes = va_arg(ap, const uint8_t *);
+                const char *digits = (*p == 'H') ? hex_upper : hex_lower;
+
+                for (int i = 0; i < precision; i++) {
+                    const char pair[2] = {digits[bytes[i] >> 4], digits[bytes[i] & 0x0F]};
+
+                    append(str, str_size, &offset, pair, 2);
+                }
+                break;
+            }
+            case 's': {
+                const char *s = va_arg(ap, const char *);
+                size_t len = strlen(s);
+
+                if (precision >= 0) {
+                    len = strnlen(s, (size_t) precision);
+                }
+                append(str, str_size, &offset, s, len);
+                break;
+            }
+            case 'd':
+                append(str, str_size, &offset, tmp, (size_t) sprintf(tmp, "%d", va_arg(ap, int)));
+                break;
+            case 'u':
+                append(str,
+                       str_size,
+                       &offset,
+                       tmp,
+                       (size_t) sprintf(tmp, "%u", va_arg(ap, unsigned int)));
+                break;
+            case 'c':
+                tmp[0] = (char) va_arg(ap, int);
+                append(str, str_size, &offset, tmp, 1);
+                break;
+            case '%':
+                append(str, str_size, &offset, "%", 1);
+                break;
+            default:
+                fprintf(stderr, "snprintf: unsupported format \"%s\"\n", format);
+                abort();
+        }
+    }
+    va_end(ap);
+
+    if (str_size > 0) {
+        str[offset < str_size ? offset : str_size - 1] = '\0';
+    }
+
+    return (int) offset;
+}
+
+unsigned int os_global_pin_is_validated() {
+    return BOLOS_UX_OK;
+}
+
+unsigned int os_setting_get(unsigned int setting_id, unsigned char *value, unsigned int max_len) {
+    (void) setting_id;
+    (void) value;
+    (void) max_len;
+
+    return 0;
+}
+
+void os_boot() {
+    G_try_last_open_context = NULL;
+}
+
+void os_sched_exit(int exit_code) {
+    exit(exit_code);
+}
+
+void halt() {
+    abort();
+}
+
+void nvm_write(void *dst, void *src, unsigned int len) {
+    // N_storage_real is const like in flash, its pages are left writable
+    const uintptr_t page_size = (uintptr_t) sysconf(_SC_PAGESIZE);
+    const uintptr_t start = (uintptr_t) dst & ~(page_size - 1);
+    const size_t size = (uintptr_t) dst + len - start;
+
+    if (mprotect((void *) start, size, PROT_READ | PROT_WRITE) != 0) {
+        perror("nvm_write");
+        abort();
+    }
+    memcpy(dst, src, len);
+}
+
+void io_seproxyhal_init() {
+}
+
+void io_seproxyhal_display_default(bagl_element_t *element) {
+    (void) element;
+}
+
+unsigned int io_seproxyhal_spi_is_status_sent() {
+    return 1;
+}
+
+void io_seproxyhal_general_status() {
+}
+
+void io_seproxyhal_spi_send(const uint8_t *buffer, uint16_t length) {
+    (void) buffer;
+    (void) length;
+}
+
+uint16_t io_seproxyhal_spi_recv(uint8_t *buffer, uint16_t max_length, unsigned int flags) {
+    (void) buffer;
+    (void) max_length;
+    (void) flags;
+
+    return 0;
+}
+
+void USB_power(unsigned char enabled) {
+    (void) enabled;
+}
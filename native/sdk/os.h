@@ -0,0 +1,152 @@
+/*****************************************************************************
+ *   Native (host) stand-in of the BOLOS SDK os.h, only what the app uses.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+#include <string.h>  // memset, explicit_bzero
+#include <stdio.h>   // snprintf
+#include <setjmp.h>  // jmp_buf, setjmp, longjmp
+
+#define PRINTF(...)
+
+#define PIC(x) ((void *) (x))
+
+#define U4BE(buf, off)                                                   \
+    (((uint32_t) (buf)[(off)] << 24) | ((uint32_t) (buf)[(off) + 1] << 16) | \
+     ((uint32_t) (buf)[(off) + 2] << 8) | (uint32_t) (buf)[(off) + 3])
+
+/**
+ * BOLOS snprintf() with its %.*H / %.*h hexadecimal extension, which the
+ * C library does not know.
+ */
+int native_snprintf(char *str, size_t str_size, const char *format, ...);
+#define snprintf native_snprintf
+
+/*
+ * Exceptions, same setjmp/longjmp layout as the SDK.
+ */
+
+typedef unsigned short exception_t;
+
+typedef struct try_context_s try_context_t;
+
+struct try_context_s {
+    jmp_buf jmp_buf;                /// context to restore on THROW()
+    try_context_t *previous;        /// enclosing context
+    volatile exception_t ex;        /// exception being handled, 0 if none
+};
+
+try_context_t *try_context_get(void);
+try_context_t *try_context_set(try_context_t *context);
+void os_longjmp(unsigned int exception) __attribute__((noreturn));
+
+#define BEGIN_TRY_L(L) \
+    {                  \
+        try_context_t __try##L;
+
+#define TRY_L(L)                                   \
+    __try##L.ex = setjmp(__try##L.jmp_buf);        \
+    if (__try##L.ex == 0) {                        \
+        __try##L.previous = try_context_set(&__try##L);
+
+#define CATCH_L(L, x)                             \
+    goto __FINALLY##L;                            \
+    }                                             \
+    else if (__try##L.ex == (x)) {                \
+        __try##L.ex = 0;                          \
+        try_context_set(__try##L.previous);
+
+#define CATCH_OTHER_L(L, e)                       \
+    goto __FINALLY##L;                            \
+    }                                             \
+    else if (__try##L.ex) {                       \
+        exception_t e = __try##L.ex;              \
+        __try##L.ex = 0;                          \
+        try_context_set(__try##L.previous);
+
+#define CATCH_ALL_L(L)                            \
+    goto __FINALLY##L;                            \
+    }                                             \
+    else if (__try##L.ex) {                       \
+        __try##L.ex = 0;                          \
+        try_context_set(__try##L.previous);
+
+#define FINALLY_L(L)                              \
+    goto __FINALLY##L;                            \
+    }                                             \
+    __FINALLY##L:                                 \
+    if (try_context_get() == &__try##L) {         \
+        try_context_set(__try##L.previous);       \
+    }
+
+#define END_TRY_L(L)                   \
+    if (__try##L.ex != 0) {            \
+        THROW_L(L, __try##L.ex);       \
+    }                                  \
+    }
+
+#define CLOSE_TRY_L(L) try_context_set(__try##L.previous)
+#define THROW_L(L, x) os_longjmp(x)
+
+#define BEGIN_TRY BEGIN_TRY_L(__)
+#define TRY TRY_L(__)
+#define CATCH(x) CATCH_L(__, x)
+#define CATCH_OTHER(e) CATCH_OTHER_L(__, e)
+#define CATCH_ALL CATCH_ALL_L(__)
+#define FINALLY FINALLY_L(__)
+#define END_TRY END_TRY_L(__)
+#define CLOSE_TRY CLOSE_TRY_L(__)
+#define THROW(x) os_longjmp(x)
+
+#define EXCEPTION 1
+#define INVALID_PARAMETER 2
+#define EXCEPTION_IO_RESET 0x10
+
+/*
+ * APDU transport.
+ */
+
+#ifndef IO_APDU_BUFFER_SIZE
+#define IO_APDU_BUFFER_SIZE (5 + 255)
+#endif
+
+extern uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+#define CHANNEL_APDU 0
+#define CHANNEL_KEYBOARD 1
+#define CHANNEL_SPI 2
+#define IO_RESET_AFTER_REPLIED 0x80
+#define IO_RECEIVE_DATA 0x40
+#define IO_RETURN_AFTER_TX 0x20
+#define IO_ASYNCH_REPLY 0x10
+#define IO_FLAGS 0xF8
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len);
+
+/*
+ * System calls.
+ */
+
+#define HDW_NORMAL 0
+#define HDW_ED25519_SLIP10 1
+
+#define BOLOS_UX_OK 0xAA
+#define OS_SETTING_PLANEMODE 1
+
+void os_perso_derive_node_bip32_seed_key(unsigned int mode,
+                                         unsigned int curve,
+                                         const unsigned int *path,
+                                         unsigned int path_len,
+                                         unsigned char *private_key,
+                                         unsigned char *chain,
+                                         unsigned char *seed_key,
+                                         unsigned int seed_key_len);
+unsigned int os_global_pin_is_validated(void);
+unsigned int os_setting_get(unsigned int setting_id, unsigned char *value, unsigned int max_len);
+void os_boot(void);
+void os_sched_exit(int exit_code) __attribute__((noreturn));
+void halt(void);
+void nvm_write(void *dst, void *src, unsigned int len);
@@ -0,0 +1,29 @@
+/*****************************************************************************
+ *   Native (host) stand-in of the BOLOS SDK os_io_seproxyhal.h.
+ *****************************************************************************/
+
+#pragma once
+
+#include "os.h"
+#include "ux.h"
+
+#define SEPROXYHAL_TAG_BUTTON_PUSH_EVENT 0x05
+#define SEPROXYHAL_TAG_STATUS_EVENT 0x01
+#define SEPROXYHAL_TAG_DISPLAY_PROCESSED_EVENT 0x0D
+#define SEPROXYHAL_TAG_TICKER_EVENT 0x0E
+#define SEPROXYHAL_TAG_STATUS_EVENT_FLAG_USB_POWERED 0x00000001
+
+typedef enum {
+    IO_APDU_MEDIA_NONE = 0,
+    IO_APDU_MEDIA_USB_HID = 1,
+} io_apdu_media_t;
+
+extern io_apdu_media_t G_io_apdu_media;
+
+void io_seproxyhal_init(void);
+void io_seproxyhal_display_default(bagl_element_t *element);
+unsigned int io_seproxyhal_spi_is_status_sent(void);
+void io_seproxyhal_general_status(void);
+void io_seproxyhal_spi_send(const uint8_t *buffer, uint16_t length);
+uint16_t io_seproxyhal_spi_recv(uint8_t *buffer, uint16_t max_length, unsigned int flags);
+void USB_power(unsigned char enabled);
@@ -0,0 +1,41 @@
+/*****************************************************************************
+ *   Native (host) stand-in of the BOLOS SDK UX flows and of the glyphs.
+ *****************************************************************************/
+
+#include <stddef.h>  // NULL
+
+#include "ux.h"
+#include "glyphs.h"
+
+const bagl_icon_details_t C_aptos_logo = {14, 14};
+const bagl_icon_details_t C_icon_back = {14, 14};
+const bagl_icon_details_t C_icon_certificate = {14, 14};
+const bagl_icon_details_t C_icon_coggle = {14, 14};
+const bagl_icon_details_t C_icon_crossmark = {14, 14};
+const bagl_icon_details_t C_icon_dashboard_x = {14, 14};
+const bagl_icon_details_t C_icon_eye = {14, 14};
+const bagl_icon_details_t C_icon_validate_14 = {14, 14};
+const bagl_icon_details_t C_icon_warning = {14, 14};
+
+static const ux_flow_step_t *const *G_native_flow = NULL;
+
+void ux_flow_init(unsigned int stack_slot,
+                  const ux_flow_step_t *const *steps,
+                  const ux_flow_step_t *const start_step) {
+    const ux_flow_step_t *step = (start_step != NULL) ? start_step : steps[0];
+
+    G_native_flow = steps;
+
+    // the first displayed step is rendered right away, like on device
+    if (step->init != NULL) {
+        step->init(stack_slot);
+    }
+}
+
+void ux_stack_push() {
+    G_ux.stack_count++;
+}
+
+const ux_flow_step_t *const *native_ux_current_flow() {
+    return G_native_flow;
+}
@@ -0,0 +1,97 @@
+/*****************************************************************************
+ *   Native (host) stand-in of the BOLOS SDK ux.h.
+ *
+ *   Steps keep their name so that the replay harness can find the approve
+ *   and reject steps of a flow and press them.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "os.h"
+
+typedef struct {
+    int type;
+} bagl_element_t;
+
+typedef struct {
+    unsigned int width;
+    unsigned int height;
+} bagl_icon_details_t;
+
+typedef struct {
+    unsigned int stack_count;
+} ux_state_t;
+
+typedef struct {
+    unsigned int ux_id;
+} bolos_ux_params_t;
+
+/**
+ * Parameters of every layout, positional ones fill icon and lines.
+ */
+typedef struct {
+    const void *icon;
+    const char *line1;
+    const char *line2;
+    const char *line3;
+    const char *title;
+    const char *text;
+} ux_layout_params_t;
+
+typedef struct {
+    const char *name;                  /// name of the step variable
+    const ux_layout_params_t *params;  /// displayed content
+    void (*validate)(void);            /// action of both buttons, NULL if none
+    void (*init)(unsigned int stack_slot);  /// called before display, NULL if none
+} ux_flow_step_t;
+
+typedef const ux_flow_step_t *const ux_flow_t[];
+
+#define FLOW_END_STEP ((const ux_flow_step_t *) 0xFFFFFFFFUL)
+#define FLOW_BARRIER ((const ux_flow_step_t *) 0xFFFFFFFEUL)
+#define FLOW_LOOP ((const ux_flow_step_t *) 0xFFFFFFFDUL)
+
+#define UX_STEP_NOCB(stepname, layoutkind, ...)                       \
+    static const ux_layout_params_t stepname##_val = __VA_ARGS__;     \
+    const ux_flow_step_t stepname = {#stepname, &stepname##_val, NULL, NULL}
+
+#define UX_STEP_NOCB_INIT(stepname, layoutkind, preinit, ...)         \
+    static void stepname##_init(unsigned int stack_slot) {            \
+        (void) stack_slot;                                            \
+        preinit;                                                      \
+    }                                                                 \
+    static const ux_layout_params_t stepname##_val = __VA_ARGS__;     \
+    const ux_flow_step_t stepname = {#stepname, &stepname##_val, NULL, stepname##_init}
+
+#define UX_STEP_CB(stepname, layoutkind, validate_cb, ...)            \
+    static void stepname##_validate(void) {                           \
+        validate_cb;                                                  \
+    }                                                                 \
+    static const ux_layout_params_t stepname##_val = __VA_ARGS__;     \
+    const ux_flow_step_t stepname = {#stepname, &stepname##_val, stepname##_validate, NULL}
+
+#define UX_STEP_VALID(stepname, layoutkind, validate_cb, ...) \
+    UX_STEP_CB(stepname, layoutkind, validate_cb, __VA_ARGS__)
+
+#define UX_FLOW(flowname, ...) \
+    const ux_flow_step_t *const flowname[] = {__VA_ARGS__, FLOW_END_STEP}
+
+#define UX_BUTTON_PUSH_EVENT(seph_packet)
+#define UX_DISPLAYED_EVENT(displayed_callback)
+#define UX_TICKER_EVENT(seph_packet, callback)
+#define UX_DEFAULT_EVENT()
+
+extern ux_state_t G_ux;
+
+void ux_flow_init(unsigned int stack_slot,
+                  const ux_flow_step_t *const *steps,
+                  const ux_flow_step_t *const start_step);
+void ux_stack_push(void);
+
+/**
+ * Flow displayed last by ux_flow_init(), NULL before the first one.
+ */
+const ux_flow_step_t *const *native_ux_current_flow(void);
@@ -0,0 +1,115 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // memcmp, memmove, memset
+
+#include "cache.h"
+
+void abi_cache_init(abi_cache_t *cache) {
+    memset(cache, 0, sizeof(*cache));
+}
+
+static void abi_cache_touch(abi_cache_t *cache, abi_cache_entry_t *entry) {
+    entry->last_used = ++cache->clock;
+}
+
+/**
+ * Whether two descriptors describe the same entry function.
+ */
+static bool abi_same_function(const abi_descriptor_t *a, const abi_descriptor_t *b) {
+    return memcmp(a->module_address, b->module_address, ADDRESS_LEN) == 0 &&               //
+           a->module_name.len == b->module_name.len &&                                     //
+           memcmp(a->module_name.bytes, b->module_name.bytes, a->module_name.len) == 0 &&  //
+           a->function_name.len == b->function_name.len &&                                 //
+           memcmp(a->function_name.bytes, b->function_name.bytes, a->function_name.len) == 0;
+}
+
+bool abi_cache_put(abi_cache_t *cache,
+                   const uint8_t *body,
+                   size_t body_len,
+                   const uint8_t digest[static ABI_DIGEST_LEN]) {
+    abi_descriptor_t abi;
+    abi_descriptor_t cached;
+    abi_cache_entry_t *entry = NULL;
+
+    if (!abi_descriptor_parse(body, body_len, &abi)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < ABI_CACHE_SIZE && entry == NULL; i++) {
+        abi_cache_entry_t *candidate = &cache->entries[i];
+        if (candidate->body_len == 0 ||
+            !abi_descriptor_parse(candidate->body, candidate->body_len, &cached)) {
+            continue;
+        }
+        // a new version of a descriptor replaces the old one
+        if (abi_same_function(&cached, &abi)) {
+            entry = candidate;
+        }
+    }
+    for (size_t i = 0; i < ABI_CACHE_SIZE && entry == NULL; i++) {
+        if (cache->entries[i].body_len == 0) {
+            entry = &cache->entries[i];
+        }
+    }
+    if (entry == NULL) {
+        entry = &cache->entries[0];
+        for (size_t i = 1; i < ABI_CACHE_SIZE; i++) {
+            if (cache->entries[i].last_used < entry->last_used) {
+                entry = &cache->entries[i];
+            }
+        }
+    }
+
+    memmove(entry->body, body, body_len);
+    entry->body_len = (uint8_t) body_len;
+    memmove(entry->digest, digest, ABI_DIGEST_LEN);
+    abi_cache_touch(cache, entry);
+
+    return true;
+}
+
+bool abi_cache_contains(abi_cache_t *cache, const uint8_t digest[static ABI_DIGEST_LEN]) {
+    for (size_t i = 0; i < ABI_CACHE_SIZE; i++) {
+        abi_cache_entry_t *entry = &cache->entries[i];
+        if (entry->body_len != 0 && memcmp(entry->digest, digest, ABI_DIGEST_LEN) == 0) {
+            abi_cache_touch(cache, entry);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool abi_cache_find(abi_cache_t *cache,
+                    const entry_function_payload_t *function,
+                    abi_descriptor_t *abi) {
+    for (size_t i = 0; i < ABI_CACHE_SIZE; i++) {
+        abi_cache_entry_t *entry = &cache->entries[i];
+        if (entry->body_len != 0 &&                                    //
+            abi_descriptor_parse(entry->body, entry->body_len, abi) &&  //
+            abi_descriptor_match(abi, function)) {
+            abi_cache_touch(cache, entry);
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "descriptor.h"
+
+/**
+ * Number of descriptors kept in RAM, the least recently used one is
+ * replaced by a new descriptor once they are all used.
+ */
+#ifdef TARGET_NANOS
+#define ABI_CACHE_SIZE 1
+#else
+#define ABI_CACHE_SIZE 4
+#endif
+
+/**
+ * Length of the digest identifying a descriptor, SHA3-256 of its body.
+ */
+#define ABI_DIGEST_LEN 32
+
+/**
+ * Structure with one cached descriptor, unused while body_len is 0.
+ */
+typedef struct {
+    uint8_t body[ABI_DESCRIPTOR_MAX_LEN];  /// verified descriptor body
+    uint8_t body_len;                      /// length of descriptor body
+    uint8_t digest[ABI_DIGEST_LEN];        /// SHA3-256 of descriptor body
+    uint32_t last_used;                    /// value of the cache clock when last used
+} abi_cache_entry_t;
+
+/**
+ * Structure with the descriptors cache.
+ */
+typedef struct {
+    abi_cache_entry_t entries[ABI_CACHE_SIZE];
+    uint32_t clock;  /// incremented each time an entry is used
+} abi_cache_t;
+
+/**
+ * Empty the cache.
+ *
+ * @param[out] cache
+ *   Pointer to descriptors cache.
+ *
+ */
+void abi_cache_init(abi_cache_t *cache);
+
+/**
+ * Add a verified descriptor to the cache. It replaces the descriptor of the
+ * same function if there is one, else it takes an unused entry, else the
+ * least recently used one.
+ *
+ * @param[in,out] cache
+ *   Pointer to descriptors cache.
+ * @param[in]     body
+ *   Pointer to descriptor body.
+ * @param[in]     body_len
+ *   Length of descriptor body.
+ * @param[in]     digest
+ *   SHA3-256 of descriptor body.
+ *
+ * @return true if success, false if the body is not a valid descriptor.
+ *
+ */
+bool abi_cache_put(abi_cache_t *cache,
+                   const uint8_t *body,
+                   size_t body_len,
+                   const uint8_t digest[static ABI_DIGEST_LEN]);
+
+/**
+ * Whether a descriptor is cached, it counts as used if so.
+ *
+ * @param[in,out] cache
+ *   Pointer to descriptors cache.
+ * @param[in]     digest
+ *   SHA3-256 of descriptor body.
+ *
+ * @return true if cached, false otherwise.
+ *
+ */
+bool abi_cache_contains(abi_cache_t *cache, const uint8_t digest[static ABI_DIGEST_LEN]);
+
+/**
+ * Find the descriptor of an entry function, it counts as used if found.
+ *
+ * @param[in,out] cache
+ *   Pointer to descriptors cache.
+ * @param[in]     function
+ *   Pointer to deserialized entry function.
+ * @param[out]    abi
+ *   Pointer to decoded descriptor, pointing into the cache until the
+ *   entry is replaced.
+ *
+ * @return true if found, false otherwise.
+ *
+ */
+bool abi_cache_find(abi_cache_t *cache,
+                    const entry_function_payload_t *function,
+                    abi_descriptor_t *abi);
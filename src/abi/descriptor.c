@@ -0,0 +1,119 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // memcmp, memset
+
+#include "descriptor.h"
+#include "../common/buffer.h"
+
+/**
+ * Whether a name is a Move identifier: letters, digits and underscores,
+ * not starting with a digit.
+ */
+static bool abi_identifier_check(const fixed_bytes_t *name) {
+    if (name->len == 0 || name->len > ABI_NAME_MAX_LEN) {
+        return false;
+    }
+    if (name->bytes[0] >= '0' && name->bytes[0] <= '9') {
+        return false;
+    }
+    for (size_t i = 0; i < name->len; i++) {
+        const uint8_t c = name->bytes[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+              c == '_')) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Read a name prefixed by its length on one byte.
+ */
+static bool abi_name_read(buffer_t *buf, fixed_bytes_t *name) {
+    uint8_t len = 0;
+
+    if (!buffer_read_u8(buf, &len) || !buffer_can_read(buf, len)) {
+        return false;
+    }
+    name->bytes = (uint8_t *) buf->ptr + buf->offset;
+    name->len = len;
+
+    return buffer_seek_cur(buf, len) && abi_identifier_check(name);
+}
+
+bool abi_descriptor_parse(const uint8_t *body, size_t body_len, abi_descriptor_t *abi) {
+    buffer_t buf = {.ptr = body, .size = body_len, .offset = 0};
+    uint8_t version = 0;
+
+    memset(abi, 0, sizeof(*abi));
+    if (body_len > ABI_DESCRIPTOR_MAX_LEN) {
+        return false;
+    }
+
+    if (!buffer_read_u8(&buf, &version) || version != ABI_DESCRIPTOR_VERSION) {
+        return false;
+    }
+    if (!buffer_can_read(&buf, ADDRESS_LEN)) {
+        return false;
+    }
+    abi->module_address = (uint8_t *) buf.ptr + buf.offset;
+    buffer_seek_cur(&buf, ADDRESS_LEN);
+    if (!abi_name_read(&buf, &abi->module_name) || !abi_name_read(&buf, &abi->function_name)) {
+        return false;
+    }
+
+    if (!buffer_read_u8(&buf, &abi->args_size) || abi->args_size > ABI_ARGS_MAX) {
+        return false;
+    }
+    for (size_t i = 0; i < abi->args_size; i++) {
+        abi_arg_t *arg = &abi->args[i];
+
+        if (!abi_name_read(&buf, &arg->name) ||  //
+            !buffer_read_u8(&buf, &arg->type) ||  //
+            !buffer_read_u8(&buf, &arg->decimals)) {
+            return false;
+        }
+        if (arg->type > ABI_TYPE_BYTES) {
+            return false;
+        }
+        // only amounts have decimals
+        if (arg->decimals != 0 &&
+            ((arg->type != ABI_TYPE_U64 && arg->type != ABI_TYPE_U128) ||
+             arg->decimals > ABI_DECIMALS_MAX)) {
+            return false;
+        }
+    }
+
+    return buf.offset == buf.size;
+}
+
+bool abi_descriptor_match(const abi_descriptor_t *abi, const entry_function_payload_t *function) {
+    return memcmp(abi->module_address, function->module_id.address, ADDRESS_LEN) == 0 &&  //
+           abi->module_name.len == function->module_id.name.len &&                     //
+           memcmp(abi->module_name.bytes,
+                  function->module_id.name.bytes,
+                  abi->module_name.len) == 0 &&                        //
+           abi->function_name.len == function->function_name.len &&  //
+           memcmp(abi->function_name.bytes,
+                  function->function_name.bytes,
+                  abi->function_name.len) == 0;
+}
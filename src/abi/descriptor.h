@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "../bcs/types.h"
+
+/**
+ * Version of the descriptor layout.
+ */
+#define ABI_DESCRIPTOR_VERSION 1
+
+/**
+ * Length of the Ed25519 signature of a descriptor body.
+ */
+#define ABI_SIGNATURE_LEN 64
+
+/**
+ * Maximum length of a descriptor body, so that the body and its
+ * signature fit in the command data of one short APDU.
+ */
+#define ABI_DESCRIPTOR_MAX_LEN (255 - ABI_SIGNATURE_LEN)
+
+/**
+ * Maximum length of module, function and argument names.
+ */
+#define ABI_NAME_MAX_LEN 32
+
+/**
+ * Maximum number of arguments described.
+ */
+#define ABI_ARGS_MAX 8
+
+/**
+ * Maximum number of decimals of an amount argument.
+ */
+#define ABI_DECIMALS_MAX 18
+
+/**
+ * Enumeration of the types of entry function arguments.
+ */
+typedef enum {
+    ABI_TYPE_BOOL = 0,     /// bool
+    ABI_TYPE_U8 = 1,       /// u8
+    ABI_TYPE_U16 = 2,      /// u16
+    ABI_TYPE_U32 = 3,      /// u32
+    ABI_TYPE_U64 = 4,      /// u64, amount when decimals is set
+    ABI_TYPE_U128 = 5,     /// u128, amount when decimals is set
+    ABI_TYPE_U256 = 6,     /// u256
+    ABI_TYPE_ADDRESS = 7,  /// address
+    ABI_TYPE_STRING = 8,   /// 0x1::string::String
+    ABI_TYPE_BYTES = 9     /// vector<u8>
+} abi_type_e;
+
+/**
+ * Structure with one described argument.
+ */
+typedef struct {
+    fixed_bytes_t name;  /// argument name, title of its screen
+    uint8_t type;        /// abi_type_e
+    uint8_t decimals;    /// decimals of an amount, 0 otherwise
+} abi_arg_t;
+
+/**
+ * Structure with a decoded descriptor, fields point into its body.
+ */
+typedef struct {
+    uint8_t *module_address;      /// ADDRESS_LEN bytes
+    fixed_bytes_t module_name;    /// module name
+    fixed_bytes_t function_name;  /// function name
+    uint8_t args_size;            /// number of arguments
+    abi_arg_t args[ABI_ARGS_MAX];
+} abi_descriptor_t;
+
+/**
+ * Decode a descriptor body:
+ *
+ *   version (1) || module address (32) ||
+ *   module name length (1) || module name ||
+ *   function name length (1) || function name ||
+ *   args count (1) || args count * (name length (1) || name || type (1) || decimals (1))
+ *
+ * Names are Move identifiers of 1 to ABI_NAME_MAX_LEN characters.
+ *
+ * @param[in]  body
+ *   Pointer to descriptor body, which must outlive abi.
+ * @param[in]  body_len
+ *   Length of descriptor body.
+ * @param[out] abi
+ *   Pointer to decoded descriptor.
+ *
+ * @return true if the body is a valid descriptor, false otherwise.
+ *
+ */
+bool abi_descriptor_parse(const uint8_t *body, size_t body_len, abi_descriptor_t *abi);
+
+/**
+ * Whether a descriptor describes an entry function, by module address,
+ * module name and function name.
+ *
+ * @param[in] abi
+ *   Pointer to decoded descriptor.
+ * @param[in] function
+ *   Pointer to deserialized entry function.
+ *
+ * @return true if they match, false otherwise.
+ *
+ */
+bool abi_descriptor_match(const abi_descriptor_t *abi, const entry_function_payload_t *function);
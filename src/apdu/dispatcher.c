@@ -28,7 +28,12 @@
 #include "../handler/get_version.h"
 #include "../handler/get_app_name.h"
 #include "../handler/get_public_key.h"
+#include "../handler/get_public_keys.h"
 #include "../handler/sign_tx.h"
+#include "../handler/sign_tx_batch.h"
+#include "../handler/get_profile.h"
+#include "../handler/get_settings.h"
+#include "../handler/provide_abi.h"
 
 int apdu_dispatcher(const command_t *cmd) {
     if (cmd->cla != CLA) {
@@ -51,6 +56,20 @@ int apdu_dispatcher(const command_t *cmd) {
 
             return handler_get_app_name();
         case GET_PUBLIC_KEY:
+            if (cmd->p1 > 1 || (cmd->p2 != 0 && cmd->p2 != P2_ADDRESS)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_get_public_key(&buf, (bool) cmd->p1, cmd->p2 == P2_ADDRESS);
+        case GET_PUBLIC_KEYS:
             if (cmd->p1 > 1 || cmd->p2 > 0) {
                 return io_send_sw(SW_WRONG_P1P2);
             }
@@ -63,7 +82,7 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.size = cmd->lc;
             buf.offset = 0;
 
-            return handler_get_public_key(&buf, (bool) cmd->p1);
+            return handler_get_public_keys(&buf, (bool) cmd->p1);
         case SIGN_TX:
             if ((cmd->p1 == P1_START && cmd->p2 != P2_MORE) ||  //
                 cmd->p1 > P1_MAX ||                             //
@@ -80,6 +99,52 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.offset = 0;
 
             return handler_sign_tx(&buf, cmd->p1, (bool) (cmd->p2 & P2_MORE));
+        case SIGN_TX_BATCH:
+            if ((cmd->p1 == P1_START && cmd->p2 != P2_LAST) ||  //
+                cmd->p1 > P1_MAX ||                             //
+                (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_sign_tx_batch(&buf, cmd->p1, (bool) (cmd->p2 & P2_MORE));
+        case GET_SETTINGS:
+            if (cmd->p1 != 0 || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            return handler_get_settings();
+#ifdef HAVE_ABI_DESCRIPTORS
+        case PROVIDE_ABI:
+            if (cmd->p1 > P1_ABI_CHECK || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_provide_abi(&buf, cmd->p1 == P1_ABI_CHECK);
+#endif
+#ifdef HAVE_PROFILING
+        case GET_PROFILE:
+            if (cmd->p1 != 0 || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            return handler_get_profile();
+#endif
         default:
             return io_send_sw(SW_INS_NOT_SUPPORTED);
     }
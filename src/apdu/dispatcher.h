@@ -10,6 +10,10 @@
  * Parameter 2 for more APDU to receive.
  */
 #define P2_MORE 0x80
+/**
+ * Parameter 2 for GET_PUBLIC_KEY to append the account address to the response.
+ */
+#define P2_ADDRESS 0x01
 /**
  * Parameter 1 for first APDU number.
  */
@@ -17,7 +21,15 @@
 /**
  * Parameter 1 for maximum APDU number.
  */
-#define P1_MAX 0x03
+#define P1_MAX (MAX_TRANSACTION_LEN / 255 + 1)
+/**
+ * Parameter 1 for PROVIDE_ABI to add a signed descriptor to the cache.
+ */
+#define P1_ABI_PROVIDE 0x00
+/**
+ * Parameter 1 for PROVIDE_ABI to tell whether a descriptor is cached.
+ */
+#define P1_ABI_CHECK 0x01
 
 /**
  * Dispatch APDU command received to the right handler.
@@ -22,10 +22,35 @@
 #include "parser.h"
 #include "../types.h"
 #include "../offsets.h"
+#include "../constants.h"
 
 bool apdu_parser(command_t *cmd, uint8_t *buf, size_t buf_len) {
-    // Check minimum length and Lc field of APDU command
-    if (buf_len < OFFSET_CDATA || buf_len - OFFSET_CDATA != buf[OFFSET_LC]) {
+    size_t offset_cdata = OFFSET_CDATA;
+    size_t lc = 0;
+
+    // Check minimum length of APDU command
+    if (buf_len < OFFSET_CDATA) {
+        return false;
+    }
+
+    if (buf_len > OFFSET_CDATA && buf[OFFSET_LC] == 0) {
+        // Extended Lc: 0x00 followed by 2 bytes, only sent when the transport
+        // buffer is large enough for more than 255 bytes of command data
+        if (buf_len < OFFSET_EXT_CDATA) {
+            return false;
+        }
+        offset_cdata = OFFSET_EXT_CDATA;
+        lc = (size_t) buf[OFFSET_EXT_LC] << 8 | buf[OFFSET_EXT_LC + 1];
+        // never trust Lc beyond the largest command data or what was received
+        if (lc > MAX_EXT_LC || lc > buf_len - OFFSET_EXT_CDATA) {
+            return false;
+        }
+    } else {
+        lc = buf[OFFSET_LC];
+    }
+
+    // Check Lc field of APDU command
+    if (buf_len - offset_cdata != lc) {
         return false;
     }
 
@@ -33,8 +58,8 @@ bool apdu_parser(command_t *cmd, uint8_t *buf, size_t buf_len) {
     cmd->ins = (command_e) buf[OFFSET_INS];
     cmd->p1 = buf[OFFSET_P1];
     cmd->p2 = buf[OFFSET_P2];
-    cmd->lc = buf[OFFSET_LC];
-    cmd->data = (buf[OFFSET_LC] > 0) ? buf + OFFSET_CDATA : NULL;
+    cmd->lc = (uint16_t) lc;
+    cmd->data = (lc > 0) ? buf + offset_cdata : NULL;
 
     return true;
 }
@@ -9,6 +9,10 @@
 /**
  * Parse APDU command from byte buffer.
  *
+ * Both short (1-byte Lc) and extended (0x00 || 2-byte Lc) command data
+ * lengths are accepted, the latter up to MAX_EXT_LC bytes and never beyond
+ * the bytes received.
+ *
  * @param[out] cmd
  *   Structured APDU command (CLA, INS, P1, P2, Lc, Command data).
  * @param[in]  buf
@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "decoder.h"
+#include "init.h"
 #include "utf8.h"
 
 bool bcs_read_bool(buffer_t *buffer, bool *value) {
@@ -220,97 +221,162 @@ bool bcs_read_type_tag_fixed(buffer_t *buffer, type_tag_t *ty_val) {
         case TYPE_TAG_ADDRESS:
         case TYPE_TAG_SIGNER:
             ty_val->size = ADDRESS_LEN;
-            return bcs_read_fixed_bytes(buffer, (uint8_t *) &ty_val->value, ADDRESS_LEN);
+            return bcs_read_ptr_to_fixed_bytes(buffer, (uint8_t **) &ty_val->value, ADDRESS_LEN);
         default:
             return false;
     }
 }
 
-/* TODO: optimize memory handling before use
-bool bcs_read_type_tag_vector(buffer_t *buffer, type_tag_t *vector_val) {
-    if (!bcs_read_u32_from_uleb128(buffer, (uint32_t *) vector_val->size)) {
+bool bcs_skip_bytes(buffer_t *buffer) {
+    size_t len = 0;
+    if (!bcs_read_length(buffer, &len)) {
         return false;
     }
-    vector_val->value = (type_tag_t *) malloc(sizeof(type_tag_t) * vector_val->size);
-    for (size_t i = 0; i < vector_val->size; i++) {
-        if (!bcs_read_u32_from_uleb128(buffer, (uint32_t *) (*(type_tag_t *)
-vector_val->value).type_tag)) { return false;
-        }
-        if ((*(type_tag_t *) vector_val->value).type_tag < TYPE_TAG_VECTOR) {
-            if (!bcs_read_type_tag_fixed(buffer, &(*(type_tag_t *) vector_val->value))) {
-                return false;
-            }
-        } else if ((*(type_tag_t *) vector_val->value).type_tag == TYPE_TAG_VECTOR) {
-            if (!bcs_read_type_tag_vector(buffer, &(*(type_tag_t *) vector_val->value))) {
-                return false;
-            }
-        } else if ((*(type_tag_t *) vector_val->value).type_tag == TYPE_TAG_STRUCT) {
-            (*(type_tag_t *) vector_val->value).size = sizeof(type_tag_struct_t);
-            (*(type_tag_t *) vector_val->value).value = (type_tag_struct_t *)
-malloc(sizeof(type_tag_struct_t)); type_tag_struct_init((*(type_tag_t *) vector_val->value).value);
+    return buffer_seek_cur(buffer, len);
+}
 
-            if (!bcs_read_type_tag_struct(buffer, (*(type_tag_t *) vector_val->value).value)) {
-                return false;
-            }
-        }
+bool bcs_skip_script_arg(buffer_t *buffer) {
+    uint32_t variant = SCRIPT_ARG_UNDEFINED;
+    if (!bcs_read_variant_index(buffer, &variant)) {
+        return false;
     }
-    return true;
+
+    switch (variant) {
+        case SCRIPT_ARG_U8:
+        case SCRIPT_ARG_BOOL:
+            return buffer_seek_cur(buffer, sizeof(uint8_t));
+        case SCRIPT_ARG_U16:
+            return buffer_seek_cur(buffer, sizeof(uint16_t));
+        case SCRIPT_ARG_U32:
+            return buffer_seek_cur(buffer, sizeof(uint32_t));
+        case SCRIPT_ARG_U64:
+            return buffer_seek_cur(buffer, sizeof(uint64_t));
+        case SCRIPT_ARG_U128:
+            return buffer_seek_cur(buffer, sizeof(uint128_t));
+        case SCRIPT_ARG_U256:
+            return buffer_seek_cur(buffer, 2 * sizeof(uint128_t));
+        case SCRIPT_ARG_ADDRESS:
+            return buffer_seek_cur(buffer, ADDRESS_LEN);
+        case SCRIPT_ARG_U8_VECTOR:
+            return bcs_skip_bytes(buffer);
+        default:
+            return false;
+    }
+}
+
+void bcs_arena_reset(bcs_arena_t *arena) {
+    arena->used = 0;
+}
+
+void *bcs_arena_alloc(bcs_arena_t *arena, size_t size) {
+    // keep every allocation aligned for pointers and size_t
+    const size_t aligned_size = (size + 7) & ~(size_t) 7;
+    if (aligned_size < size || aligned_size > sizeof(arena->buf) - arena->used) {
+        return NULL;
+    }
+
+    void *ptr = arena->buf + arena->used;
+    arena->used += aligned_size;
+    return ptr;
 }
-*/
 
-/* TODO: optimize memory handling before use
-bool bcs_read_type_tag_struct(buffer_t *buffer, type_tag_struct_t *ty_struct) {
-    if (!bcs_read_fixed_bytes(buffer, (uint8_t *) &ty_struct->address, ADDRESS_LEN)) {
+static bool bcs_read_type_tag_struct_nested(buffer_t *buffer,
+                                            bcs_arena_t *arena,
+                                            type_tag_struct_t *ty_struct,
+                                            uint8_t depth);
+
+static bool bcs_read_type_tag_nested(buffer_t *buffer,
+                                     bcs_arena_t *arena,
+                                     type_tag_t *ty_val,
+                                     uint8_t depth) {
+    if (depth > MAX_TYPE_TAG_NESTING) {
         return false;
     }
-    if (!bcs_read_u32_from_uleb128(buffer, (uint32_t *) &ty_struct->module_name.len)) {
+
+    uint32_t type_tag = TYPE_TAG_UNDEFINED;
+    if (!bcs_read_variant_index(buffer, &type_tag)) {
         return false;
     }
-    ty_struct->module_name.bytes = (uint8_t *) malloc(sizeof(uint8_t) * ty_struct->module_name.len);
-    if (!bcs_read_fixed_bytes(buffer, (uint8_t *) &ty_struct->module_name.bytes,
-ty_struct->module_name.len)) { return false;
+
+    ty_val->type_tag = type_tag;
+    ty_val->size = 0;
+    ty_val->value = NULL;
+
+    switch (type_tag) {
+        case TYPE_TAG_BOOL:
+        case TYPE_TAG_U8:
+        case TYPE_TAG_U64:
+        case TYPE_TAG_U128:
+        case TYPE_TAG_ADDRESS:
+        case TYPE_TAG_SIGNER:
+        case TYPE_TAG_U16:
+        case TYPE_TAG_U32:
+        case TYPE_TAG_U256:
+            return true;
+        case TYPE_TAG_VECTOR:
+            ty_val->size = sizeof(type_tag_t);
+            ty_val->value = bcs_arena_alloc(arena, sizeof(type_tag_t));
+            return ty_val->value != NULL &&
+                   bcs_read_type_tag_nested(buffer, arena, ty_val->value, depth + 1);
+        case TYPE_TAG_STRUCT:
+            ty_val->size = sizeof(type_tag_struct_t);
+            ty_val->value = bcs_arena_alloc(arena, sizeof(type_tag_struct_t));
+            return ty_val->value != NULL &&
+                   bcs_read_type_tag_struct_nested(buffer, arena, ty_val->value, depth + 1);
+        default:
+            return false;
     }
-    if (!bcs_read_u32_from_uleb128(buffer, (uint32_t *) &ty_struct->name.len)) {
+}
+
+static bool bcs_read_type_tag_struct_nested(buffer_t *buffer,
+                                            bcs_arena_t *arena,
+                                            type_tag_struct_t *ty_struct,
+                                            uint8_t depth) {
+    uint32_t len = 0;
+
+    type_tag_struct_init(ty_struct);
+    if (!bcs_read_ptr_to_fixed_bytes(buffer, &ty_struct->address, ADDRESS_LEN)) {
         return false;
     }
-    ty_struct->name.bytes = (uint8_t *) malloc(sizeof(uint8_t) * ty_struct->name.len);
-    if (!bcs_read_fixed_bytes(buffer, (uint8_t *) &ty_struct->name.bytes, ty_struct->name.len)) {
+    if (!bcs_read_u32_from_uleb128(buffer, &len) ||
+        !bcs_read_ptr_to_fixed_bytes(buffer, &ty_struct->module_name.bytes, len)) {
         return false;
     }
-    if (!bcs_read_u32_from_uleb128(buffer, (uint32_t *) &ty_struct->type_args_size)) {
+    ty_struct->module_name.len = len;
+    if (!bcs_read_u32_from_uleb128(buffer, &len) ||
+        !bcs_read_ptr_to_fixed_bytes(buffer, &ty_struct->name.bytes, len)) {
         return false;
     }
-    if (ty_struct->type_args_size > 0) {
-        ty_struct->type_args = (type_tag_t *) malloc(sizeof(type_tag_t) *
-ty_struct->type_args_size); for (size_t i = 0; i < ty_struct->type_args_size; i++) {
-            ty_struct->type_args[i].type_tag = 0;
-            ty_struct->type_args[i].size = 0;
-            ty_struct->type_args[i].value = NULL;
+    ty_struct->name.len = len;
+    if (!bcs_read_u32_from_uleb128(buffer, &len)) {
+        return false;
+    }
+    ty_struct->type_args_size = len;
+    if (len == 0) {
+        return true;
+    }
 
-            if (!bcs_read_u32_from_uleb128(buffer, (uint32_t *) &ty_struct->type_args[i].type_tag))
-{ return false;
-            }
-            if (ty_struct->type_args[i].type_tag < TYPE_TAG_VECTOR) {
-                if (!bcs_read_type_tag_fixed(buffer, (type_tag_t *) &ty_struct->type_args[i].value))
-{ return false;
-                }
-            } else if (ty_struct->type_args[i].type_tag == TYPE_TAG_VECTOR) {
-                if (!bcs_read_type_tag_vector(buffer, &ty_struct->type_args[i])) {
-                    return false;
-                }
-            } else if (ty_struct->type_args[i].type_tag == TYPE_TAG_STRUCT) {
-                ty_struct->type_args[i].size = sizeof(type_tag_struct_t);
-                ty_struct->type_args[i].value = (type_tag_struct_t *)
-malloc(sizeof(type_tag_struct_t)); type_tag_struct_init(ty_struct->type_args[i].value);
-
-                if (!bcs_read_type_tag_struct(buffer, ty_struct->type_args[i].value)) {
-                    return false;
-                }
-            } else {
-                return false;
-            }
+    // every type arg takes at least one byte, reject sizes the buffer cannot hold
+    if (!buffer_can_read(buffer, len)) {
+        return false;
+    }
+    ty_struct->type_args = bcs_arena_alloc(arena, len * sizeof(type_tag_t));
+    if (ty_struct->type_args == NULL) {
+        return false;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        if (!bcs_read_type_tag_nested(buffer, arena, &ty_struct->type_args[i], depth)) {
+            return false;
         }
     }
+
     return true;
 }
-*/
+
+bool bcs_read_type_tag(buffer_t *buffer, bcs_arena_t *arena, type_tag_t *ty_val) {
+    return bcs_read_type_tag_nested(buffer, arena, ty_val, 0);
+}
+
+bool bcs_read_type_tag_struct(buffer_t *buffer, bcs_arena_t *arena, type_tag_struct_t *ty_struct) {
+    return bcs_read_type_tag_struct_nested(buffer, arena, ty_struct, 0);
+}
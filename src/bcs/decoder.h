@@ -33,7 +33,11 @@ bool bcs_read_dynamic_bytes(buffer_t *buffer, uint8_t *out, size_t out_size, siz
 
 bool bcs_read_type_tag_fixed(buffer_t *buffer, type_tag_t *ty_val);
 
-// TODO: optimize memory handling before use
-// bool bcs_read_type_tag_vector(buffer_t *buffer, type_tag_t *vector_val);
-// TODO: optimize memory handling before use
-// bool bcs_read_type_tag_struct(buffer_t *buffer, type_tag_struct_t *ty_struct);
+bool bcs_skip_bytes(buffer_t *buffer);
+bool bcs_skip_script_arg(buffer_t *buffer);
+
+void bcs_arena_reset(bcs_arena_t *arena);
+void *bcs_arena_alloc(bcs_arena_t *arena, size_t size);
+
+bool bcs_read_type_tag(buffer_t *buffer, bcs_arena_t *arena, type_tag_t *ty_val);
+bool bcs_read_type_tag_struct(buffer_t *buffer, bcs_arena_t *arena, type_tag_struct_t *ty_struct);
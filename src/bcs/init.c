@@ -1,6 +1,7 @@
-#include <string.h>
+#include <stddef.h>  // NULL
 
 #include "init.h"
+#include "decoder.h"
 
 void type_tag_init(type_tag_t *type_tag) {
     type_tag->type_tag = 0;
@@ -9,7 +10,7 @@ void type_tag_init(type_tag_t *type_tag) {
 }
 
 void type_tag_struct_init(type_tag_struct_t *type_tag_struct) {
-    memset(&type_tag_struct->address, 0, ADDRESS_LEN);
+    type_tag_struct->address = NULL;
     fixed_bytes_init(&type_tag_struct->module_name);
     fixed_bytes_init(&type_tag_struct->name);
     type_tag_struct->type_args_size = 0;
@@ -22,7 +23,7 @@ void fixed_bytes_init(fixed_bytes_t *fixed_bytes) {
 }
 
 void module_id_init(module_id_t *module_id) {
-    memset(module_id->address, 0, ADDRESS_LEN);
+    module_id->address = NULL;
     fixed_bytes_init(&module_id->name);
 }
 
@@ -43,7 +44,7 @@ void script_payload_init(script_payload_t *payload) {
 }
 
 void transaction_init(aptos_transaction_t *tx) {
-    memset(tx->sender, 0, ADDRESS_LEN);
+    tx->sender = NULL;
     tx->tx_variant = TX_UNDEFINED;
     tx->sequence = 0;
     tx->payload_variant = PAYLOAD_UNDEFINED;
@@ -51,4 +52,10 @@ void transaction_init(aptos_transaction_t *tx) {
     tx->gas_unit_price = 0;
     tx->expiration_timestamp_secs = 0;
     tx->chain_id = 0;
+    tx->with_data_variant = TX_WITH_DATA_UNDEFINED;
+    tx->secondary_signers_size = 0;
+    tx->secondary_signers = NULL;
+    tx->fee_payer = NULL;
+    fixed_bytes_init(&tx->message);
+    bcs_arena_reset(&tx->arena);
 }
@@ -3,10 +3,20 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "../common/uint128.h"
+
 // Maximum length allowed for sequence (vectors, bytes, strings) and maps
 #define MAX_SEQUENCE_LENGTH ((1ull << 31) - 1)
 // Maximum number of nested structs and enum variants
 #define MAX_CONTAINER_DEPTH 500
+// Maximum nesting of type tags, same limit as the Move type tag deserializer
+#define MAX_TYPE_TAG_NESTING 8
+// Size of the arena holding decoded type tags of a transaction
+#ifdef TARGET_NANOS
+#define TYPE_TAG_ARENA_SIZE 192
+#else
+#define TYPE_TAG_ARENA_SIZE 1024
+#endif
 // Address size
 #define ADDRESS_LEN 32
 // default coin module
@@ -29,16 +39,13 @@ static const uint8_t PREFIX_RAW_TX_WITH_DATA_HASHED[] = {
     94, 250, 60, 79,  2,   248, 58, 15,  75,  45,  105, 252, 149, 198, 7,   204,
     2,  130, 92, 196, 231, 190, 83, 110, 240, 153, 45,  240, 80,  217, 230, 124};
 
-typedef struct {
-    uint64_t high;
-    uint64_t low;
-} uint128_t;
-
 typedef struct {
     int64_t high;
     uint64_t low;
 } int128_t;
 
+// Decoded transaction fields point into the serialized transaction
+// buffer, which must outlive the structures below.
 typedef struct {
     uint8_t *bytes;
     size_t len;
@@ -53,9 +60,33 @@ typedef enum {
     TYPE_TAG_SIGNER = 5,
     TYPE_TAG_VECTOR = 6,
     TYPE_TAG_STRUCT = 7,
+    TYPE_TAG_U16 = 8,
+    TYPE_TAG_U32 = 9,
+    TYPE_TAG_U256 = 10,
     TYPE_TAG_UNDEFINED = 1000
 } type_tag_variant_t;
 
+typedef enum {
+    SCRIPT_ARG_U8 = 0,
+    SCRIPT_ARG_U64 = 1,
+    SCRIPT_ARG_U128 = 2,
+    SCRIPT_ARG_ADDRESS = 3,
+    SCRIPT_ARG_U8_VECTOR = 4,
+    SCRIPT_ARG_BOOL = 5,
+    SCRIPT_ARG_U16 = 6,
+    SCRIPT_ARG_U32 = 7,
+    SCRIPT_ARG_U256 = 8,
+    SCRIPT_ARG_UNDEFINED = 1000
+} script_arg_variant_t;
+
+// Bump allocator for nested type tags, freed at once by resetting used
+typedef struct {
+    uint8_t buf[TYPE_TAG_ARENA_SIZE] __attribute__((aligned(8)));
+    size_t used;
+} bcs_arena_t;
+
+// value points to the element type_tag_t of a vector or to the
+// type_tag_struct_t of a struct, and is NULL for other type tags
 typedef struct {
     type_tag_variant_t type_tag;
     size_t size;
@@ -63,7 +94,7 @@ typedef struct {
 } type_tag_t;
 
 typedef struct {
-    uint8_t address[ADDRESS_LEN];
+    uint8_t *address;  // ADDRESS_LEN bytes
     fixed_bytes_t module_name;
     fixed_bytes_t name;
     size_t type_args_size;
@@ -71,14 +102,23 @@ typedef struct {
 } type_tag_struct_t;
 
 typedef struct {
-    uint8_t address[ADDRESS_LEN];
+    uint8_t *address;  // ADDRESS_LEN bytes
     fixed_bytes_t name;
 } module_id_t;
 
 typedef enum {
     FUNC_UNKNOWN = 0,
     FUNC_APTOS_ACCOUNT_TRANSFER = 1,
-    FUNC_COIN_TRANSFER = 2
+    FUNC_COIN_TRANSFER = 2,
+    FUNC_APTOS_ACCOUNT_TRANSFER_COINS = 3,
+    FUNC_COIN_REGISTER = 4,
+    FUNC_STAKE_ADD_STAKE = 5,
+    FUNC_STAKE_UNLOCK = 6,
+    FUNC_STAKE_WITHDRAW = 7,
+    FUNC_DELEGATION_POOL_ADD_STAKE = 8,
+    FUNC_DELEGATION_POOL_UNLOCK = 9,
+    FUNC_DELEGATION_POOL_REACTIVATE_STAKE = 10,
+    FUNC_DELEGATION_POOL_WITHDRAW = 11
 } entry_function_known_type_t;
 
 typedef struct {
@@ -87,16 +127,29 @@ typedef struct {
 } agrs_raw_t;
 
 typedef struct {
-    uint8_t receiver[ADDRESS_LEN];
+    uint8_t *receiver;  // ADDRESS_LEN bytes
     uint64_t amount;
 } agrs_aptos_account_trasfer_t;
 
 typedef struct {
-    uint8_t receiver[ADDRESS_LEN];
+    uint8_t *receiver;  // ADDRESS_LEN bytes
     uint64_t amount;
     type_tag_struct_t ty_coin;
 } agrs_coin_trasfer_t;
 
+typedef struct {
+    type_tag_struct_t ty_coin;
+} agrs_coin_register_t;
+
+typedef struct {
+    uint64_t amount;
+} agrs_stake_t;
+
+typedef struct {
+    uint8_t *pool_address;  // ADDRESS_LEN bytes
+    uint64_t amount;
+} agrs_delegation_pool_t;
+
 typedef struct {
     module_id_t module_id;
     fixed_bytes_t function_name;
@@ -108,6 +161,9 @@ typedef struct {
             agrs_raw_t raw;
             agrs_aptos_account_trasfer_t transfer;
             agrs_coin_trasfer_t coin_transfer;
+            agrs_coin_register_t coin_register;
+            agrs_stake_t stake;
+            agrs_delegation_pool_t delegation_pool;
         };
     } args;
 } entry_function_payload_t;
@@ -122,6 +178,12 @@ typedef struct {
 
 typedef enum { TX_RAW = 0, TX_RAW_WITH_DATA = 1, TX_MESSAGE = 2, TX_UNDEFINED = 1000 } tx_variant_t;
 
+typedef enum {
+    TX_WITH_DATA_MULTI_AGENT = 0,
+    TX_WITH_DATA_FEE_PAYER = 1,
+    TX_WITH_DATA_UNDEFINED = 1000
+} tx_with_data_variant_t;
+
 typedef enum {
     PAYLOAD_SCRIPT = 0,
     PAYLOAD_ENTRY_FUNCTION = 2,
@@ -130,7 +192,7 @@ typedef enum {
 
 typedef struct {
     tx_variant_t tx_variant;
-    uint8_t sender[ADDRESS_LEN];
+    uint8_t *sender;  // ADDRESS_LEN bytes
     uint64_t sequence;
     payload_variant_t payload_variant;
     union {
@@ -141,4 +203,11 @@ typedef struct {
     uint64_t gas_unit_price;
     uint64_t expiration_timestamp_secs;
     uint8_t chain_id;
+    // RawTransactionWithData only
+    tx_with_data_variant_t with_data_variant;
+    size_t secondary_signers_size;
+    uint8_t *secondary_signers;  // secondary_signers_size * ADDRESS_LEN contiguous bytes
+    uint8_t *fee_payer;          // ADDRESS_LEN bytes, TX_WITH_DATA_FEE_PAYER only
+    fixed_bytes_t message;       // TX_MESSAGE only
+    bcs_arena_t arena;           // storage of decoded type args
 } aptos_transaction_t;
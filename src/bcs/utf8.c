@@ -1,8 +1,10 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "utf8.h"
+#include "../common/ascii.h"
 
 bool try_push_char(uint8_t *out, size_t *out_len, uint8_t ch, size_t max_len) {
     if (*out_len < max_len) {
@@ -30,10 +32,16 @@ int try_utf8_to_ascii(const uint8_t *in,
     size_t i = 0;
     while (i < in_len) {
         if (in[i] < 0x80) {
-            if (!try_push_char(out, &out_len, in[i] & 0x7f, max_out_len)) {
+            // copy the whole ASCII run at once
+            const size_t run_len = ascii_prefix_len(in + i, in_len - i);
+
+            if (run_len > max_out_len - out_len) {
+                memcpy(out + out_len, in + i, max_out_len - out_len);
                 return -2;
             }
-            ++i;
+            memcpy(out + out_len, in + i, run_len);
+            out_len += run_len;
+            i += run_len;
         } else if ((in[i] & 0xe0) == 0xc0) {
             /* 110XXXXx 10xxxxxx */
             if (i + 1 >= in_len || (in[i + 1] & 0xc0) != 0x80 ||
@@ -0,0 +1,68 @@
+#include <stdint.h>  // uint*_t, uintptr_t
+#include <stddef.h>  // size_t
+
+#if defined(__AVX2__)
+#include <immintrin.h>  // _mm256_*, _mm_*
+#elif defined(__SSE2__)
+#include <emmintrin.h>  // _mm_*
+#endif
+
+#include "ascii.h"
+
+/**
+ * Machine word, which may alias the bytes it is loaded from.
+ */
+typedef uintptr_t __attribute__((may_alias)) ascii_word_t;
+
+/**
+ * Word with the high bit of each of its bytes set.
+ */
+#define ASCII_WORD_HIGH_BITS ((uintptr_t) -1 / 0xFF * 0x80)
+
+size_t ascii_prefix_len(const uint8_t *in, size_t in_len) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 32 <= in_len; i += 32) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *) (in + i));
+        const uint32_t mask = (uint32_t) _mm256_movemask_epi8(v);
+
+        if (mask != 0) {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    for (; i + 16 <= in_len; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *) (in + i));
+        const uint32_t mask = (uint32_t) _mm_movemask_epi8(v);
+
+        if (mask != 0) {
+            return i + (size_t) __builtin_ctz(mask);
+        }
+    }
+#else
+    // byte by byte up to a word boundary, Cortex-M0 faults on unaligned loads
+    for (; i < in_len && (uintptr_t) (in + i) % sizeof(ascii_word_t) != 0; i++) {
+        if (in[i] & 0x80) {
+            return i;
+        }
+    }
+
+    for (; i + sizeof(ascii_word_t) <= in_len; i += sizeof(ascii_word_t)) {
+        if (*(const ascii_word_t *) (in + i) & ASCII_WORD_HIGH_BITS) {
+            // the loop below finds which byte of the word
+            break;
+        }
+    }
+#endif
+
+    for (; i < in_len; i++) {
+        if (in[i] & 0x80) {
+            return i;
+        }
+    }
+
+    return in_len;
+}
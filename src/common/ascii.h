@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+
+/**
+ * Length of the leading run of ASCII bytes (< 0x80) of a byte buffer.
+ *
+ * Bytes are checked a machine word at a time, or 16/32 at a time with
+ * SSE2/AVX2 when the compiler targets them (host builds).
+ *
+ * @param[in] in
+ *   Pointer to input byte buffer.
+ * @param[in] in_len
+ *   Length of input byte buffer.
+ *
+ * @return offset of the first non-ASCII byte, in_len if there is none.
+ *
+ */
+size_t ascii_prefix_len(const uint8_t *in, size_t in_len);
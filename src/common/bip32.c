@@ -62,7 +62,7 @@ bool bip32_path_format(const uint32_t *bip32_path,
         }
         offset += written;
 
-        if ((bip32_path[i] & 0x80000000u) != 0) {
+        if ((bip32_path[i] & BIP32_HARDENED) != 0) {
             snprintf(out + offset, out_len - offset, "'");
             written = strlen(out + offset);
             if (written == 0 || written >= out_len - offset) {
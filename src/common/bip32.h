@@ -9,6 +9,11 @@
  */
 #define MAX_BIP32_PATH 10
 
+/**
+ * Bit marking a hardened BIP32 path index.
+ */
+#define BIP32_HARDENED 0x80000000u
+
 /**
  * Read BIP32 path from byte buffer.
  *
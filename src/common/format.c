@@ -16,10 +16,11 @@
 
 #include <stddef.h>   // size_t
 #include <stdint.h>   // int*_t, uint*_t
-#include <string.h>   // strncpy, memmove
+#include <string.h>   // memcpy
 #include <stdbool.h>  // bool
 
 #include "format.h"
+#include "uint128.h"
 
 bool format_i64(char *dst, size_t dst_len, const int64_t value) {
     char temp[] = "-9223372036854775808";
@@ -60,75 +61,174 @@ bool format_i64(char *dst, size_t dst_len, const int64_t value) {
     return true;
 }
 
-bool format_u64(char *out, size_t outLen, uint64_t in) {
-    uint8_t i = 0;
-
-    if (outLen == 0) {
-        return false;
+/**
+ * Decimal digit pairs "00" to "99", so that two digits are emitted per
+ * division.
+ */
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * Maximum number of decimal digits of a 128-bit unsigned integer.
+ */
+#define U128_MAX_DIGITS 39
+
+/**
+ * Write decimal digits of value backward, the last one just before end.
+ *
+ * @return pointer to the first digit.
+ */
+static char *u64_digits(char *end, uint64_t value) {
+    while (value >= 100) {
+        const uint64_t quotient = value / 100;
+        const uint32_t pair = (uint32_t) (value - quotient * 100);
+
+        value = quotient;
+        end -= 2;
+        memcpy(end, DIGIT_PAIRS + 2 * pair, 2);
     }
-    outLen--;
-
-    while (in > 9) {
-        out[i] = in % 10 + '0';
-        in /= 10;
-        i++;
-        if (i + 1 > outLen) {
-            return false;
-        }
+    if (value >= 10) {
+        end -= 2;
+        memcpy(end, DIGIT_PAIRS + 2 * value, 2);
+    } else {
+        *--end = (char) ('0' + value);
     }
-    out[i] = in + '0';
-    out[i + 1] = '\0';
-
-    uint8_t j = 0;
-    char tmp;
 
-    // revert the string
-    while (j < i) {
-        // swap out[j] and out[i]
-        tmp = out[j];
-        out[j] = out[i];
-        out[i] = tmp;
+    return end;
+}
 
-        i--;
-        j++;
+/**
+ * Write exactly 9 decimal digits of value (< 10^9) backward, zero padded.
+ *
+ * @return pointer to the first digit.
+ */
+static char *u32_digits_9(char *end, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        const uint32_t pair = value % 100;
+
+        value /= 100;
+        end -= 2;
+        memcpy(end, DIGIT_PAIRS + 2 * pair, 2);
     }
-    return true;
-}
+    *--end = (char) ('0' + value);
 
-bool format_fpu64(char *dst, size_t dst_len, const uint64_t value, uint8_t decimals) {
-    char buffer[21] = {0};
+    return end;
+}
 
-    if (!format_u64(buffer, sizeof(buffer), value)) {
-        return false;
+/**
+ * Write decimal digits of value backward, the last one just before end.
+ *
+ * @return pointer to the first digit.
+ */
+static char *u128_digits(char *end, const uint128_t *value) {
+    uint128_t n = *value;
+
+    // 9 digits per 128-bit division until the rest fits in 64 bits
+    while (n.high != 0) {
+        end = u32_digits_9(end, u128_div_pow10(&n, &n, 9));
     }
 
-    size_t digits = strlen(buffer);
+    return u64_digits(end, n.low);
+}
 
-    if (digits <= decimals) {
-        if (dst_len <= 2 + decimals - digits) {
+/**
+ * Copy digits to dst with a decimal separator before the last decimals.
+ */
+static bool format_fixed_point(char *dst,
+                               size_t dst_len,
+                               const char *digits,
+                               size_t digits_len,
+                               uint8_t decimals) {
+    // byte copies: the digits were just written two at a time, wider loads
+    // of memcpy() would stall on store forwarding
+    if (digits_len <= decimals) {
+        const size_t zeros = decimals - digits_len;
+
+        if (dst_len <= 2 + zeros + digits_len) {
             return false;
         }
         *dst++ = '0';
         *dst++ = '.';
-        for (uint16_t i = 0; i < decimals - digits; i++, dst++) {
-            *dst = '0';
+        for (size_t i = 0; i < zeros; i++) {
+            *dst++ = '0';
+        }
+        for (size_t i = 0; i < digits_len; i++) {
+            *dst++ = digits[i];
         }
-        dst_len -= 2 + decimals - digits;
-        strncpy(dst, buffer, dst_len);
     } else {
-        if (dst_len <= digits + 1 + decimals) {
+        const size_t shift = digits_len - decimals;
+
+        if (dst_len <= digits_len + 1 + decimals) {
             return false;
         }
+        for (size_t i = 0; i < shift; i++) {
+            *dst++ = digits[i];
+        }
+        *dst++ = '.';
+        for (size_t i = shift; i < digits_len; i++) {
+            *dst++ = digits[i];
+        }
+    }
+    *dst = '\0';
+
+    return true;
+}
+
+bool format_u64(char *dst, size_t dst_len, uint64_t value) {
+    char buffer[20];
+    char *end = buffer + sizeof(buffer);
+    const char *digits = u64_digits(end, value);
+    const size_t digits_len = (size_t) (end - digits);
 
-        const size_t shift = digits - decimals;
-        memmove(dst, buffer, shift);
-        dst[shift] = '.';
-        strncpy(dst + shift + 1, buffer + shift, decimals);
+    if (dst_len < digits_len + 1) {
+        return false;
     }
+    memcpy(dst, digits, digits_len);
+    dst[digits_len] = '\0';
 
     return true;
 }
 
+bool format_fpu64(char *dst, size_t dst_len, const uint64_t value, uint8_t decimals) {
+    char buffer[20];
+    char *end = buffer + sizeof(buffer);
+    const char *digits = u64_digits(end, value);
+
+    return format_fixed_point(dst, dst_len, digits, (size_t) (end - digits), decimals);
+}
+
+bool format_u128(char *dst, size_t dst_len, const uint128_t *value) {
+    char buffer[U128_MAX_DIGITS];
+    char *end = buffer + sizeof(buffer);
+    const char *digits = u128_digits(end, value);
+    const size_t digits_len = (size_t) (end - digits);
+
+    if (dst_len < digits_len + 1) {
+        return false;
+    }
+    memcpy(dst, digits, digits_len);
+    dst[digits_len] = '\0';
+
+    return true;
+}
+
+bool format_fpu128(char *dst, size_t dst_len, const uint128_t *value, uint8_t decimals) {
+    char buffer[U128_MAX_DIGITS];
+    char *end = buffer + sizeof(buffer);
+    const char *digits = u128_digits(end, value);
+
+    return format_fixed_point(dst, dst_len, digits, (size_t) (end - digits), decimals);
+}
+
 int format_hex(const uint8_t *in, size_t in_len, char *out, size_t out_len) {
     if (out_len < 2 * in_len + 1) {
         return -1;
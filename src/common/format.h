@@ -4,6 +4,8 @@
 #include <stdint.h>   // int*_t, uint*_t
 #include <stdbool.h>  // bool
 
+#include "uint128.h"
+
 /**
  * Format 64-bit signed integer as string.
  *
@@ -51,6 +53,38 @@ bool format_u64(char *dst, size_t dst_len, uint64_t value);
  */
 bool format_fpu64(char *dst, size_t dst_len, const uint64_t value, uint8_t decimals);
 
+/**
+ * Format 128-bit unsigned integer as string.
+ *
+ * @param[out] dst
+ *   Pointer to output string.
+ * @param[in]  dst_len
+ *   Length of output string.
+ * @param[in]  value
+ *   Pointer to 128-bit unsigned integer to format.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool format_u128(char *dst, size_t dst_len, const uint128_t *value);
+
+/**
+ * Format 128-bit unsigned integer as string with decimals.
+ *
+ * @param[out] dst
+ *   Pointer to output string.
+ * @param[in]  dst_len
+ *   Length of output string.
+ * @param[in]  value
+ *   Pointer to 128-bit unsigned integer to format.
+ * @param[in]  decimals
+ *   Number of digits after decimal separator.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool format_fpu128(char *dst, size_t dst_len, const uint128_t *value, uint8_t decimals);
+
 /**
  * Format byte buffer to uppercase hexadecimal string.
  *
@@ -0,0 +1,56 @@
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "uint128.h"
+
+void u128_mul_u64(uint128_t *r, uint64_t a, uint64_t b) {
+    // 32x32 -> 64 partial products, the only multiplication of Cortex-M
+    const uint64_t a_lo = (uint32_t) a;
+    const uint64_t a_hi = a >> 32;
+    const uint64_t b_lo = (uint32_t) b;
+    const uint64_t b_hi = b >> 32;
+
+    const uint64_t lo_lo = a_lo * b_lo;
+    const uint64_t hi_lo = a_hi * b_lo;
+    const uint64_t lo_hi = a_lo * b_hi;
+    const uint64_t hi_hi = a_hi * b_hi;
+
+    // middle column, cannot overflow: (2^32 - 1) * 3 < 2^64
+    const uint64_t cross = (lo_lo >> 32) + (uint32_t) hi_lo + (uint32_t) lo_hi;
+
+    r->low = (cross << 32) | (uint32_t) lo_lo;
+    r->high = hi_hi + (hi_lo >> 32) + (lo_hi >> 32) + (cross >> 32);
+}
+
+uint32_t u128_divmod_u32(uint128_t *q, const uint128_t *n, uint32_t d) {
+    const uint32_t limbs[4] = {(uint32_t) (n->high >> 32),
+                               (uint32_t) n->high,
+                               (uint32_t) (n->low >> 32),
+                               (uint32_t) n->low};
+    uint32_t quotient[4] = {0};
+    uint64_t rem = 0;
+
+    // schoolbook division by 32-bit limbs, rem < d keeps each step in 64 bits
+    for (int i = 0; i < 4; i++) {
+        const uint64_t cur = (rem << 32) | limbs[i];
+
+        quotient[i] = (uint32_t) (cur / d);
+        rem = cur % d;
+    }
+
+    q->high = ((uint64_t) quotient[0] << 32) | quotient[1];
+    q->low = ((uint64_t) quotient[2] << 32) | quotient[3];
+
+    return (uint32_t) rem;
+}
+
+uint32_t u128_div_pow10(uint128_t *q, const uint128_t *n, uint8_t k) {
+    static const uint32_t POW10[10] =
+        {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+    return u128_divmod_u32(q, n, POW10[k < 9 ? k : 9]);
+}
+
+bool u128_is_zero(const uint128_t *n) {
+    return n->high == 0 && n->low == 0;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+/**
+ * 128-bit unsigned integer, made of two 64-bit halves since the
+ * compilers of the devices have no native 128-bit type.
+ */
+typedef struct {
+    uint64_t high;
+    uint64_t low;
+} uint128_t;
+
+/**
+ * Full product of two 64-bit unsigned integers.
+ *
+ * @param[out] r
+ *   Pointer to 128-bit unsigned integer, a * b.
+ * @param[in]  a
+ *   64-bit unsigned integer.
+ * @param[in]  b
+ *   64-bit unsigned integer.
+ *
+ */
+void u128_mul_u64(uint128_t *r, uint64_t a, uint64_t b);
+
+/**
+ * Divide 128-bit unsigned integer by 32-bit unsigned integer.
+ *
+ * @param[out] q
+ *   Pointer to 128-bit unsigned integer, n / d. May be n.
+ * @param[in]  n
+ *   Pointer to 128-bit unsigned integer to divide.
+ * @param[in]  d
+ *   32-bit unsigned integer divisor, not 0.
+ *
+ * @return remainder n % d.
+ *
+ */
+uint32_t u128_divmod_u32(uint128_t *q, const uint128_t *n, uint32_t d);
+
+/**
+ * Divide 128-bit unsigned integer by 10^k.
+ *
+ * @param[out] q
+ *   Pointer to 128-bit unsigned integer, n / 10^k. May be n.
+ * @param[in]  n
+ *   Pointer to 128-bit unsigned integer to divide.
+ * @param[in]  k
+ *   Power of 10 of the divisor, at most 9.
+ *
+ * @return remainder n % 10^k.
+ *
+ */
+uint32_t u128_div_pow10(uint128_t *q, const uint128_t *n, uint8_t k);
+
+/**
+ * Check whether 128-bit unsigned integer is 0.
+ *
+ * @param[in] n
+ *   Pointer to 128-bit unsigned integer.
+ *
+ * @return true if n is 0, false otherwise.
+ *
+ */
+bool u128_is_zero(const uint128_t *n);
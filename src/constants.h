@@ -22,15 +22,37 @@
 
 /**
  * Maximum transaction length (bytes).
+ * Nano S has too little RAM to buffer more than two full APDU chunks, raise
+ * it only once the link map of a Nano S build shows room beside the stack.
  */
+#ifdef TARGET_NANOS
 #define MAX_TRANSACTION_LEN 510
+#else
+#define MAX_TRANSACTION_LEN 4096
+#endif
+
+/**
+ * Maximum command data length of an extended APDU (bytes).
+ */
+#define MAX_EXT_LC 1024
 
 /**
  * Maximum signature length (bytes).
  */
 #define MAX_DER_SIG_LEN 72
 
+/**
+ * Length of the message hash, SHA3-256 of the signing message (bytes).
+ */
+#define MESSAGE_HASH_LEN 32
+
 /**
  * Exponent used to convert mBOL to BOL unit (N BOL = N * 10^3 mBOL).
  */
 #define EXPONENT_SMALLEST_UNIT 3
+
+/**
+ * Maximum number of public keys or addresses (32 bytes each) in one
+ * GET_PUBLIC_KEYS response.
+ */
+#define MAX_PUBLIC_KEYS_PER_RESPONSE 7
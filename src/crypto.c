@@ -16,12 +16,25 @@
  *****************************************************************************/
 
 #include <stdint.h>   // uint*_t
-#include <string.h>   // memset, explicit_bzero
+#include <string.h>   // memset, memcmp, memmove, explicit_bzero
 #include <stdbool.h>  // bool
 
 #include "crypto.h"
 
 #include "globals.h"
+#include "profiling.h"
+#include "common/bip32.h"
+
+/**
+ * Public key and chain code of the last derived BIP32 path.
+ */
+static struct {
+    bool valid;
+    uint8_t bip32_path_len;
+    uint32_t bip32_path[MAX_BIP32_PATH];
+    uint8_t raw_public_key[32];
+    uint8_t chain_code[32];
+} s_public_key_cache;
 
 int crypto_derive_private_key(cx_ecfp_private_key_t *private_key,
                               uint8_t chain_code[static 32],
@@ -74,20 +87,85 @@ int crypto_init_public_key(cx_ecfp_private_key_t *private_key,
     return 0;
 }
 
-int crypto_sign_message() {
-    cx_ecfp_private_key_t private_key = {0};
-    uint8_t chain_code[32] = {0};
-    int sig_len = 0;
+void crypto_clear_public_key_cache() {
+    explicit_bzero(&s_public_key_cache, sizeof(s_public_key_cache));
+}
 
-    // derive private key according to BIP32 path
-    crypto_derive_private_key(&private_key,
-                              chain_code,
-                              G_context.bip32_path,
-                              G_context.bip32_path_len);
+static bool crypto_public_key_cache_match(const uint32_t *bip32_path, uint8_t bip32_path_len) {
+    return s_public_key_cache.valid &&                          //
+           s_public_key_cache.bip32_path_len == bip32_path_len &&  //
+           memcmp(s_public_key_cache.bip32_path,
+                  bip32_path,
+                  bip32_path_len * sizeof(*bip32_path)) == 0;
+}
+
+int crypto_get_public_key(const uint32_t *bip32_path,
+                          uint8_t bip32_path_len,
+                          uint8_t raw_public_key[static 32],
+                          uint8_t chain_code[static 32]) {
+    // never serve keys cached before the device was locked
+    if (os_global_pin_is_validated() != BOLOS_UX_OK) {
+        crypto_clear_public_key_cache();
+    }
+
+    if (!crypto_public_key_cache_match(bip32_path, bip32_path_len)) {
+        cx_ecfp_private_key_t private_key = {0};
+        cx_ecfp_public_key_t public_key = {0};
+
+        if (bip32_path_len == 0 || bip32_path_len > MAX_BIP32_PATH) {
+            return -1;
+        }
+
+        crypto_clear_public_key_cache();
+
+        BEGIN_TRY {
+            TRY {
+                // derive private key according to BIP32 path
+                crypto_derive_private_key(&private_key,
+                                          s_public_key_cache.chain_code,
+                                          bip32_path,
+                                          bip32_path_len);
+                // generate corresponding public key
+                crypto_init_public_key(&private_key,
+                                       &public_key,
+                                       s_public_key_cache.raw_public_key);
+            }
+            CATCH_OTHER(e) {
+                crypto_clear_public_key_cache();
+                THROW(e);
+            }
+            FINALLY {
+                explicit_bzero(&private_key, sizeof(private_key));
+            }
+        }
+        END_TRY;
+
+        memmove(s_public_key_cache.bip32_path,
+                bip32_path,
+                bip32_path_len * sizeof(*bip32_path));
+        s_public_key_cache.bip32_path_len = bip32_path_len;
+        s_public_key_cache.valid = true;
+    }
+
+    memmove(raw_public_key, s_public_key_cache.raw_public_key, 32);
+    memmove(chain_code, s_public_key_cache.chain_code, 32);
+
+    return 0;
+}
+
+/**
+ * Sign G_context.tx_info.raw_tx with the private key, which is wiped afterwards.
+ */
+static int crypto_sign_raw_tx(cx_ecfp_private_key_t *private_key) {
+    // set within TRY and read after END_TRY, so it must survive the longjmp
+    volatile int sig_len = 0;
 
     BEGIN_TRY {
         TRY {
-            sig_len = cx_eddsa_sign(&private_key,
+            // Ed25519 hashes the whole message twice (nonce, then challenge), so it
+            // cannot be fed chunk by chunk and needs the buffered raw_tx
+            PROFILE_BEGIN(PROFILE_STAGE_SIGN);
+            sig_len = cx_eddsa_sign(private_key,
                                     CX_LAST,
                                     CX_SHA512,
                                     G_context.tx_info.raw_tx,
@@ -97,13 +175,14 @@ int crypto_sign_message() {
                                     G_context.tx_info.signature,
                                     sizeof(G_context.tx_info.signature),
                                     NULL);
+            PROFILE_END(PROFILE_STAGE_SIGN);
             PRINTF("Signature: %.*H\n", sig_len, G_context.tx_info.signature);
         }
         CATCH_OTHER(e) {
             THROW(e);
         }
         FINALLY {
-            explicit_bzero(&private_key, sizeof(private_key));
+            explicit_bzero(private_key, sizeof(*private_key));
         }
     }
     END_TRY;
@@ -116,3 +195,65 @@ int crypto_sign_message() {
 
     return 0;
 }
+
+int crypto_sign_message() {
+    cx_ecfp_private_key_t private_key = {0};
+    uint8_t chain_code[32] = {0};
+
+    // derive private key according to BIP32 path
+    PROFILE_BEGIN(PROFILE_STAGE_DERIVE);
+    crypto_derive_private_key(&private_key,
+                              chain_code,
+                              G_context.bip32_path,
+                              G_context.bip32_path_len);
+    PROFILE_END(PROFILE_STAGE_DERIVE);
+
+    return crypto_sign_raw_tx(&private_key);
+}
+
+int crypto_sign_message_with_key(const uint8_t raw_private_key[static 32]) {
+    cx_ecfp_private_key_t private_key = {0};
+
+    cx_ecfp_init_private_key(CX_CURVE_Ed25519, raw_private_key, 32, &private_key);
+
+    return crypto_sign_raw_tx(&private_key);
+}
+
+#ifdef HAVE_ABI_DESCRIPTORS
+/**
+ * Ed25519 public key trusted to sign ABI descriptors, set with ABI_SIGNER_KEY
+ * in the Makefile. The test key of HAVE_ABI_TEST_KEY is derived from a public
+ * seed (see tests/README.md) and must never be used in a release build.
+ */
+static const uint8_t ABI_SIGNER_PUBLIC_KEY[32] = {
+#ifdef HAVE_ABI_TEST_KEY
+    0xef, 0xd2, 0x91, 0xb4, 0x3f, 0x2c, 0x58, 0x93,
+    0x31, 0x85, 0xff, 0xf8, 0x3d, 0xa8, 0x09, 0xfd,
+    0x85, 0xf0, 0x93, 0x9a, 0x4e, 0x51, 0x73, 0x1a,
+    0x01, 0x30, 0x15, 0x9e, 0xac, 0xfe, 0x9b, 0xd9
+#else
+    ABI_SIGNER_KEY
+#endif
+};
+
+int crypto_verify_abi_descriptor(const uint8_t *body,
+                                 size_t body_len,
+                                 const uint8_t signature[static 64]) {
+    cx_ecfp_public_key_t public_key = {0};
+    uint8_t W[65] = {0};
+
+    // compressed point: 0x02 || y (big-endian) with the sign of x as its top bit
+    W[0] = 0x02;
+    for (int i = 0; i < 32; i++) {
+        W[1 + i] = ABI_SIGNER_PUBLIC_KEY[31 - i];
+    }
+    cx_edwards_decompress_point(CX_CURVE_Ed25519, W, sizeof(W));
+    cx_ecfp_init_public_key(CX_CURVE_Ed25519, W, sizeof(W), &public_key);
+
+    if (!cx_eddsa_verify(&public_key, CX_LAST, CX_SHA512, body, body_len, NULL, 0, signature, 64)) {
+        return -1;
+    }
+
+    return 0;
+}
+#endif
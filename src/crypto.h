@@ -2,6 +2,7 @@
 #pragma once
 
 #include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
 
 #include "os.h"
 #include "cx.h"
@@ -48,9 +49,41 @@ int crypto_init_public_key(cx_ecfp_private_key_t *private_key,
                            uint8_t raw_public_key[static 32]);
 
 /**
- * Sign message hash in global context.
+ * Get public key and chain code given BIP32 path.
  *
- * @see G_context.bip32_path, G_context.tx_info.m_hash,
+ * The public key and chain code of the last derived BIP32 path are cached,
+ * so repeated requests on the same path do not derive the key again. The
+ * cache is dropped when the device is locked or the application exits.
+ *
+ * @param[in]  bip32_path
+ *   Pointer to buffer with BIP32 path.
+ * @param[in]  bip32_path_len
+ *   Number of path in BIP32 path.
+ * @param[out] raw_public_key
+ *   Pointer to 32 bytes array for raw public key.
+ * @param[out] chain_code
+ *   Pointer to 32 bytes array for chain code.
+ *
+ * @return 0 if success, -1 otherwise.
+ *
+ * @throw INVALID_PARAMETER
+ *
+ */
+int crypto_get_public_key(const uint32_t *bip32_path,
+                          uint8_t bip32_path_len,
+                          uint8_t raw_public_key[static 32],
+                          uint8_t chain_code[static 32]);
+
+/**
+ * Wipe the cached public key and chain code.
+ *
+ */
+void crypto_clear_public_key_cache(void);
+
+/**
+ * Sign raw transaction in global context.
+ *
+ * @see G_context.bip32_path, G_context.tx_info.raw_tx,
  * G_context.tx_info.signature.
  *
  * @return 0 if success, -1 otherwise.
@@ -59,3 +92,42 @@ int crypto_init_public_key(cx_ecfp_private_key_t *private_key,
  *
  */
 int crypto_sign_message(void);
+
+/**
+ * Sign raw transaction in global context with an already derived private key.
+ *
+ * @see G_context.tx_info.raw_tx, G_context.tx_info.signature.
+ *
+ * @param[in] raw_private_key
+ *   Pointer to raw private key.
+ *
+ * @return 0 if success, -1 otherwise.
+ *
+ * @throw INVALID_PARAMETER
+ *
+ */
+int crypto_sign_message_with_key(const uint8_t raw_private_key[static 32]);
+
+#ifdef HAVE_ABI_DESCRIPTORS
+/**
+ * Verify the Ed25519 signature of an ABI descriptor body with the trusted
+ * public key of the build.
+ *
+ * @see ABI_SIGNER_KEY in Makefile.
+ *
+ * @param[in] body
+ *   Pointer to descriptor body.
+ * @param[in] body_len
+ *   Length of descriptor body.
+ * @param[in] signature
+ *   Pointer to 64 bytes Ed25519 signature of the body.
+ *
+ * @return 0 if the signature is valid, -1 otherwise.
+ *
+ * @throw INVALID_PARAMETER
+ *
+ */
+int crypto_verify_abi_descriptor(const uint8_t *body,
+                                 size_t body_len,
+                                 const uint8_t signature[static 64]);
+#endif
@@ -7,6 +7,9 @@
 #include "io.h"
 #include "types.h"
 #include "constants.h"
+#ifdef HAVE_ABI_DESCRIPTORS
+#include "abi/cache.h"
+#endif
 
 /**
  * Global buffer for interactions between SE and MCU.
@@ -27,3 +30,16 @@ extern bolos_ux_params_t G_ux_params;
  * Global context for user requests.
  */
 extern global_ctx_t G_context;
+
+#ifdef HAVE_ABI_DESCRIPTORS
+/**
+ * Verified ABI descriptors, kept in RAM until the application exits.
+ */
+extern abi_cache_t G_abi_cache;
+#endif
+
+/**
+ * Settings stored in NVM, written with nvm_write() only.
+ */
+extern const internal_storage_t N_storage_real;
+#define N_storage (*(volatile internal_storage_t *) PIC(&N_storage_real))
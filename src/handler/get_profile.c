@@ -0,0 +1,66 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#ifdef HAVE_PROFILING
+
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+#include <assert.h>  // _Static_assert
+
+#include "get_profile.h"
+#include "../globals.h"
+#include "../io.h"
+#include "../sw.h"
+#include "../types.h"
+#include "../profiling.h"
+#include "common/buffer.h"
+#include "common/write.h"
+
+// stack_size (2) || stack_used (2) || count (1) || count * record (8)
+#define PROFILE_HEADER_LEN 5
+#define PROFILE_RECORD_LEN 8
+
+int handler_get_profile() {
+    _Static_assert(PROFILE_HEADER_LEN + PROFILE_RECORDS_LEN * PROFILE_RECORD_LEN <= 255,
+                   "Profiling records must fit in one APDU response!");
+
+    const profile_ctx_t *profile = &G_context.profile;
+    uint8_t resp[PROFILE_HEADER_LEN + PROFILE_RECORDS_LEN * PROFILE_RECORD_LEN] = {0};
+    size_t offset = 0;
+
+    write_u16_be(resp, offset, profiling_stack_size());
+    offset += 2;
+    write_u16_be(resp, offset, profiling_stack_used());
+    offset += 2;
+    resp[offset++] = profile->count;
+
+    // oldest record is the next one to be overwritten once the ring is full
+    const size_t first = (profile->count < PROFILE_RECORDS_LEN) ? 0 : profile->next;
+    for (size_t i = 0; i < profile->count; i++) {
+        const profile_record_t *record = &profile->records[(first + i) % PROFILE_RECORDS_LEN];
+        resp[offset++] = record->stage;
+        resp[offset++] = record->end;
+        write_u16_be(resp, offset, record->stack_used);
+        offset += 2;
+        write_u32_be(resp, offset, record->ticks);
+        offset += 4;
+    }
+
+    return io_send_response(&(const buffer_t){.ptr = resp, .size = offset, .offset = 0}, SW_OK);
+}
+
+#endif
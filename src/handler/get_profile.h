@@ -0,0 +1,17 @@
+#pragma once
+
+#ifdef HAVE_PROFILING
+
+/**
+ * Handler for GET_PROFILE command. Send APDU response with stack size,
+ * stack high-water mark and profiling records of the last request,
+ * oldest first.
+ *
+ * @see HAVE_PROFILING in Makefile.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_profile(void);
+
+#endif
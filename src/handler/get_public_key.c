@@ -21,7 +21,6 @@
 #include <string.h>   // memset, explicit_bzero
 
 #include "os.h"
-#include "cx.h"
 
 #include "get_public_key.h"
 #include "../globals.h"
@@ -29,40 +28,41 @@
 #include "../io.h"
 #include "../sw.h"
 #include "../crypto.h"
+#include "../address.h"
 #include "../common/buffer.h"
 #include "../ui/display.h"
 #include "../helper/send_response.h"
 
 #include "../common/debug.h"
 
-int handler_get_public_key(buffer_t *cdata, bool display) {
+int handler_get_public_key(buffer_t *cdata, bool display, bool with_address) {
     explicit_bzero(&G_context, sizeof(G_context));
     G_context.req_type = CONFIRM_ADDRESS;
     G_context.state = STATE_NONE;
 
-    cx_ecfp_private_key_t private_key = {0};
-    cx_ecfp_public_key_t public_key = {0};
-
     if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
         !buffer_read_bip32_path(cdata, G_context.bip32_path, (size_t) G_context.bip32_path_len)) {
         return io_send_sw(SW_WRONG_DATA_LENGTH);
     }
 
-    // derive private key according to BIP32 path
-    crypto_derive_private_key(&private_key,
-                              G_context.pk_info.chain_code,
-                              G_context.bip32_path,
-                              G_context.bip32_path_len);
-    // generate corresponding public key
-    crypto_init_public_key(&private_key, &public_key, G_context.pk_info.raw_public_key);
+    if (crypto_get_public_key(G_context.bip32_path,
+                              G_context.bip32_path_len,
+                              G_context.pk_info.raw_public_key,
+                              G_context.pk_info.chain_code) < 0) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
 
     debug_hex_print_u32_numbers("Bip32 Path", G_context.bip32_path, G_context.bip32_path_len);
-    debug_hex_print_raw("Private Key", private_key.d, 32);
     debug_hex_print_raw("Public Key", G_context.pk_info.raw_public_key, 32);
     debug_hex_print_raw("Chain Code", G_context.pk_info.chain_code, 32);
 
-    // reset private key
-    explicit_bzero(&private_key, sizeof(private_key));
+    // address is computed once here for both screen and APDU response
+    G_context.pk_info.with_address = with_address;
+    if ((display || with_address) && !address_from_pubkey(G_context.pk_info.raw_public_key,
+                                                          G_context.pk_info.address,
+                                                          sizeof(G_context.pk_info.address))) {
+        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+    }
 
     if (display) {
         return ui_display_address();
@@ -11,15 +11,17 @@
  * Handler for GET_PUBLIC_KEY command. If successfully parse BIP32 path,
  * derive public key/chain code and send APDU response.
  *
- * @see G_context.bip32_path, G_context.pk_info.raw_public_key and
- *      G_context.pk_info.chain_code.
+ * @see G_context.bip32_path, G_context.pk_info.raw_public_key,
+ *      G_context.pk_info.chain_code and G_context.pk_info.address.
  *
  * @param[in,out] cdata
  *   Command data with BIP32 path.
  * @param[in]     display
  *   Whether to display address on screen or not.
+ * @param[in]     with_address
+ *   Whether to append address to APDU response or not.
  *
  * @return zero or positive integer if success, negative integer otherwise.
  *
  */
-int handler_get_public_key(buffer_t *cdata, bool display);
+int handler_get_public_key(buffer_t *cdata, bool display, bool with_address);
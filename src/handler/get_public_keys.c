@@ -0,0 +1,91 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // memmove, explicit_bzero
+
+#include "os.h"
+
+#include "get_public_keys.h"
+#include "../constants.h"
+#include "../globals.h"
+#include "../types.h"
+#include "../io.h"
+#include "../sw.h"
+#include "../crypto.h"
+#include "../address.h"
+#include "../common/buffer.h"
+#include "../common/bip32.h"
+#include "../transaction/types.h"
+
+int handler_get_public_keys(buffer_t *cdata, bool addresses) {
+    explicit_bzero(&G_context, sizeof(G_context));
+    G_context.req_type = CONFIRM_ADDRESS;
+    G_context.state = STATE_NONE;
+
+    uint8_t index_pos = 0;
+    uint32_t start = 0;
+    uint8_t count = 0;
+
+    if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
+        !buffer_read_bip32_path(cdata, G_context.bip32_path, (size_t) G_context.bip32_path_len) ||
+        !buffer_read_u8(cdata, &index_pos) || !buffer_read_u32(cdata, &start, BE) ||
+        !buffer_read_u8(cdata, &count) || cdata->offset != cdata->size) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
+
+    // index range must fit in the non-hardened part of the path component
+    if (index_pos >= G_context.bip32_path_len || count == 0 ||
+        count > MAX_PUBLIC_KEYS_PER_RESPONSE || start >= BIP32_HARDENED ||
+        count > BIP32_HARDENED - start) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
+
+    // response = count (1) || (public_key (32) | address (32)) * count
+    uint8_t resp[1 + MAX_PUBLIC_KEYS_PER_RESPONSE * ADDRESS_LEN] = {0};
+    size_t offset = 0;
+    const uint32_t hardened = G_context.bip32_path[index_pos] & BIP32_HARDENED;
+
+    resp[offset++] = count;
+    for (uint8_t i = 0; i < count; i++) {
+        G_context.bip32_path[index_pos] = hardened | (start + i);
+
+        if (crypto_get_public_key(G_context.bip32_path,
+                                  G_context.bip32_path_len,
+                                  G_context.pk_info.raw_public_key,
+                                  G_context.pk_info.chain_code) < 0) {
+            return io_send_sw(SW_WRONG_DATA_LENGTH);
+        }
+
+        if (addresses) {
+            if (!address_from_pubkey(G_context.pk_info.raw_public_key,
+                                     resp + offset,
+                                     sizeof(resp) - offset)) {
+                return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+            }
+        } else {
+            memmove(resp + offset,
+                    G_context.pk_info.raw_public_key,
+                    sizeof(G_context.pk_info.raw_public_key));
+        }
+        offset += ADDRESS_LEN;
+    }
+
+    return io_send_response(&(const buffer_t){.ptr = resp, .size = offset, .offset = 0}, SW_OK);
+}
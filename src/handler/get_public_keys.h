@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+
+#include "../common/buffer.h"
+
+/**
+ * Handler for GET_PUBLIC_KEYS command. If successfully parse base BIP32 path
+ * and index range, derive the public key of each index and send them (or the
+ * corresponding addresses) packed in one APDU response.
+ *
+ * @see G_context.bip32_path.
+ *
+ * @param[in,out] cdata
+ *   Command data with base BIP32 path, position of the index in the path,
+ *   first index and number of indices.
+ * @param[in]     addresses
+ *   Whether to send addresses instead of public keys or not.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_public_keys(buffer_t *cdata, bool addresses);
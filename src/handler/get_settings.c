@@ -0,0 +1,60 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>  // uint*_t
+#include <stddef.h>  // size_t
+
+#include "os.h"
+
+#include "get_settings.h"
+#include "../constants.h"
+#include "../globals.h"
+#include "../io.h"
+#include "../offsets.h"
+#include "../settings.h"
+#include "../sw.h"
+#include "common/buffer.h"
+#include "common/write.h"
+
+// version (1) || flags (1) || account_index (4) || max_cdata_len (2) || max_tx_len (2)
+#define SETTINGS_RESPONSE_LEN 10
+
+/**
+ * Maximum command data length, extended APDUs are only received when the
+ * transport buffer has room for more than 255 bytes of command data.
+ */
+#if IO_APDU_BUFFER_SIZE > OFFSET_CDATA + 255
+#define MAX_CDATA_LEN (IO_APDU_BUFFER_SIZE - OFFSET_EXT_CDATA)
+#else
+#define MAX_CDATA_LEN (IO_APDU_BUFFER_SIZE - OFFSET_CDATA)
+#endif
+
+int handler_get_settings() {
+    uint8_t resp[SETTINGS_RESPONSE_LEN] = {0};
+    size_t offset = 0;
+
+    resp[offset++] = N_storage.version;
+    resp[offset++] = settings_flags();
+    write_u32_be(resp, offset, N_storage.account_index);
+    offset += 4;
+    write_u16_be(resp, offset, MAX_CDATA_LEN);
+    offset += 2;
+    write_u16_be(resp, offset, MAX_TRANSACTION_LEN);
+    offset += 2;
+
+    return io_send_response(&(const buffer_t){.ptr = resp, .size = offset, .offset = 0}, SW_OK);
+}
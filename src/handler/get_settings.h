@@ -0,0 +1,12 @@
+#pragma once
+
+/**
+ * Handler for GET_SETTINGS command. Send APDU response with the settings
+ * stored in NVM and the limits of transactions and APDU command data.
+ *
+ * @see internal_storage_t.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_settings(void);
@@ -0,0 +1,83 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#ifdef HAVE_ABI_DESCRIPTORS
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+
+#include "os.h"
+#include "cx.h"
+
+#include "provide_abi.h"
+#include "../globals.h"
+#include "../crypto.h"
+#include "../io.h"
+#include "../sw.h"
+#include "../types.h"
+#include "../abi/cache.h"
+#include "../abi/descriptor.h"
+#include "common/buffer.h"
+
+int handler_provide_abi(buffer_t *cdata, bool check) {
+    abi_descriptor_t abi;
+    uint8_t digest[ABI_DIGEST_LEN] = {0};
+    cx_sha3_t sha3;
+
+    // descriptors found when the review started point into the cache
+    if (G_context.req_type == CONFIRM_TRANSACTION && G_context.state == STATE_PARSED) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    if (check) {
+        if (cdata->size != ABI_DIGEST_LEN) {
+            return io_send_sw(SW_WRONG_DATA_LENGTH);
+        }
+
+        const uint8_t cached = abi_cache_contains(&G_abi_cache, cdata->ptr) ? 1 : 0;
+
+        return io_send_response(&(const buffer_t){.ptr = &cached, .size = 1, .offset = 0},
+                                SW_OK);
+    }
+
+    if (cdata->size <= ABI_SIGNATURE_LEN ||
+        cdata->size > ABI_DESCRIPTOR_MAX_LEN + ABI_SIGNATURE_LEN) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
+
+    const uint8_t *body = cdata->ptr;
+    const size_t body_len = cdata->size - ABI_SIGNATURE_LEN;
+
+    if (!abi_descriptor_parse(body, body_len, &abi)) {
+        return io_send_sw(SW_ABI_DESCRIPTOR_FAIL);
+    }
+    if (crypto_verify_abi_descriptor(body, body_len, body + body_len) != 0) {
+        return io_send_sw(SW_ABI_SIGNATURE_FAIL);
+    }
+
+    cx_sha3_init(&sha3, 256);
+    cx_hash((cx_hash_t *) &sha3, CX_LAST, body, body_len, digest, sizeof(digest));
+    abi_cache_put(&G_abi_cache, body, body_len, digest);
+
+    PRINTF("ABI descriptor: %.*H\n", sizeof(digest), digest);
+
+    return io_send_response(&(const buffer_t){.ptr = digest, .size = sizeof(digest), .offset = 0},
+                            SW_OK);
+}
+
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#ifdef HAVE_ABI_DESCRIPTORS
+
+#include <stdbool.h>  // bool
+
+#include "../common/buffer.h"
+
+/**
+ * Handler for PROVIDE_ABI command. Verify a descriptor signed by the
+ * trusted key and add it to the cache, or tell whether a descriptor is
+ * already cached. Refused while a transaction is under review.
+ *
+ * @see HAVE_ABI_DESCRIPTORS in Makefile, doc/COMMANDS.md.
+ *
+ * @param[in,out] cdata
+ *   Command data with descriptor body || Ed25519 signature, or with the
+ *   SHA3-256 of a descriptor body to check.
+ * @param[in]     check
+ *   Whether to check a digest instead of adding a descriptor.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_provide_abi(buffer_t *cdata, bool check);
+
+#endif
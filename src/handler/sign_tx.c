@@ -27,11 +27,97 @@
 #include "../sw.h"
 #include "../globals.h"
 #include "../crypto.h"
+#include "../profiling.h"
 #include "../ui/display.h"
 #include "../common/buffer.h"
 #include "../transaction/types.h"
 #include "../transaction/deserialize.h"
 
+/**
+ * Message hash context, fed with each chunk of the raw transaction as it is
+ * processed so that no extra pass over raw_tx is needed after the last chunk.
+ */
+static cx_sha3_t m_message_hash_ctx;
+
+/**
+ * Length of the beginning of raw_tx already fed to m_message_hash_ctx.
+ */
+static size_t s_hashed_len;
+
+void sign_tx_start_transaction() {
+    G_context.tx_info.raw_tx_len = 0;
+    G_context.tx_info.deferred_sw = SW_OK;
+    s_hashed_len = 0;
+    cx_sha3_init(&m_message_hash_ctx, 256);
+    transaction_parser_init(&G_context.tx_info.parser, &G_context.tx_info.transaction);
+}
+
+uint16_t sign_tx_append_chunk(buffer_t *cdata) {
+    // error of a chunk already acknowledged, see handler_sign_tx()
+    if (G_context.tx_info.deferred_sw != SW_OK) {
+        return G_context.tx_info.deferred_sw;
+    }
+
+    const size_t chunk_len = cdata->size - cdata->offset;
+    uint8_t *chunk_dst = G_context.tx_info.raw_tx + G_context.tx_info.raw_tx_len;
+
+    if (G_context.tx_info.raw_tx_len + chunk_len > MAX_TRANSACTION_LEN) {
+        return SW_WRONG_TX_LENGTH;
+    }
+
+    // the stage is always closed, even when the copy fails
+    PROFILE_BEGIN(PROFILE_STAGE_CHUNK_COPY);
+    const bool copied = buffer_move(cdata, chunk_dst, chunk_len);
+    PROFILE_END(PROFILE_STAGE_CHUNK_COPY);
+    if (!copied) {
+        return SW_WRONG_TX_LENGTH;
+    }
+
+    G_context.tx_info.raw_tx_len += chunk_len;
+
+    return SW_OK;
+}
+
+uint16_t sign_tx_process_chunk(bool more) {
+    PROFILE_BEGIN(PROFILE_STAGE_HASH);
+    cx_hash((cx_hash_t *) &m_message_hash_ctx,
+            more ? 0 : CX_LAST,
+            G_context.tx_info.raw_tx + s_hashed_len,
+            G_context.tx_info.raw_tx_len - s_hashed_len,
+            G_context.tx_info.message_hash,
+            more ? 0 : sizeof(G_context.tx_info.message_hash));
+    PROFILE_END(PROFILE_STAGE_HASH);
+    s_hashed_len = G_context.tx_info.raw_tx_len;
+
+    // parse the fields received so far, the parser resumes where the previous chunk ended
+    buffer_t buf = {.ptr = G_context.tx_info.raw_tx,
+                    .size = G_context.tx_info.raw_tx_len,
+                    .offset = 0};
+
+    PROFILE_BEGIN(PROFILE_STAGE_PARSE);
+    parser_status_e status = transaction_deserialize_chunk(&G_context.tx_info.parser,
+                                                           &buf,
+                                                           &G_context.tx_info.transaction,
+                                                           more);
+    PROFILE_END(PROFILE_STAGE_PARSE);
+    PRINTF("Parsing status: %d.\n", status);
+
+    if (status != (more ? PARSING_INCOMPLETE : PARSING_OK)) {
+        return SW_TX_PARSING_FAIL;
+    }
+
+    return SW_OK;
+}
+
+uint16_t sign_tx_receive_chunk(buffer_t *cdata, bool more) {
+    uint16_t sw = sign_tx_append_chunk(cdata);
+    if (sw != SW_OK) {
+        return sw;
+    }
+
+    return sign_tx_process_chunk(more);
+}
+
 int handler_sign_tx(buffer_t *cdata, uint8_t chunk, bool more) {
     if (chunk == 0) {  // first APDU, parse BIP32 path
         explicit_bzero(&G_context, sizeof(G_context));
@@ -45,58 +131,63 @@ int handler_sign_tx(buffer_t *cdata, uint8_t chunk, bool more) {
             return io_send_sw(SW_WRONG_DATA_LENGTH);
         }
 
+        sign_tx_start_transaction();
+
         return io_send_sw(SW_OK);
     } else {  // parse transaction
-        if (G_context.req_type != CONFIRM_TRANSACTION) {
+        if (G_context.req_type != CONFIRM_TRANSACTION || G_context.state != STATE_NONE) {
             return io_send_sw(SW_BAD_STATE);
         }
 
+        uint16_t sw = sign_tx_append_chunk(cdata);
+        if (sw != SW_OK) {
+            return io_send_sw(sw);
+        }
+
         if (more) {  // more APDUs with transaction part
-            if (G_context.tx_info.raw_tx_len + cdata->size > MAX_TRANSACTION_LEN ||  //
-                !buffer_move(cdata,
-                             G_context.tx_info.raw_tx + G_context.tx_info.raw_tx_len,
-                             cdata->size)) {
-                return io_send_sw(SW_WRONG_TX_LENGTH);
+            // the chunk is copied in raw_tx: acknowledge it first so that the host sends
+            // the next one while this one is hashed and parsed, an error is then
+            // reported on the next chunk
+            if (io_send_sw_early(SW_OK) < 0) {
+                return -1;
             }
-
-            G_context.tx_info.raw_tx_len += cdata->size;
-
-            return io_send_sw(SW_OK);
-        } else {  // last APDU, let's parse and sign
-            if (G_context.tx_info.raw_tx_len + cdata->size > MAX_TRANSACTION_LEN ||  //
-                !buffer_move(cdata,
-                             G_context.tx_info.raw_tx + G_context.tx_info.raw_tx_len,
-                             cdata->size)) {
-                return io_send_sw(SW_WRONG_TX_LENGTH);
+            // the status word of this chunk is already sent, an exception thrown
+            // while hashing or parsing is kept for the next chunk as well
+            BEGIN_TRY {
+                TRY {
+                    G_context.tx_info.deferred_sw = sign_tx_process_chunk(more);
+                }
+                CATCH(EXCEPTION_IO_RESET) {
+                    THROW(EXCEPTION_IO_RESET);
+                }
+                CATCH_OTHER(e) {
+                    G_context.tx_info.deferred_sw = e;
+                }
+                FINALLY {
+                }
             }
+            END_TRY;
 
-            G_context.tx_info.raw_tx_len += cdata->size;
+            return 0;
+        }
 
-            buffer_t buf = {.ptr = G_context.tx_info.raw_tx,
-                            .size = G_context.tx_info.raw_tx_len,
-                            .offset = 0};
+        // the last chunk finalizes the hash: whether it fails, throws or gets
+        // reviewed, no further chunk is accepted in this request
+        G_context.tx_info.deferred_sw = SW_BAD_STATE;
 
-            parser_status_e status = transaction_deserialize(&buf, &G_context.tx_info.transaction);
-            PRINTF("Parsing status: %d.\n", status);
-            if (status != PARSING_OK) {
-                return io_send_sw(SW_TX_PARSING_FAIL);
-            }
-
-            G_context.state = STATE_PARSED;
+        sw = sign_tx_process_chunk(more);
+        if (sw != SW_OK) {
+            return io_send_sw(sw);
+        }
 
-            cx_sha512_t keccak256;
-            cx_sha512_init(&keccak256);
-            cx_hash((cx_hash_t *) &keccak256,
-                    CX_LAST,
-                    G_context.tx_info.raw_tx,
-                    G_context.tx_info.raw_tx_len,
-                    G_context.tx_info.m_hash,
-                    sizeof(G_context.tx_info.m_hash));
+        // last APDU, let's sign
+        G_context.state = STATE_PARSED;
 
-            PRINTF("Hash: %.*H\n", sizeof(G_context.tx_info.m_hash), G_context.tx_info.m_hash);
+        PRINTF("Message hash: %.*H\n",
+               sizeof(G_context.tx_info.message_hash),
+               G_context.tx_info.message_hash);
 
-            return ui_display_transaction();
-        }
+        return ui_display_transaction();
     }
 
     return 0;
@@ -5,6 +5,59 @@
 
 #include "../common/buffer.h"
 
+/**
+ * Reset raw transaction, message hash and parser in global context
+ * before receiving a new transaction.
+ *
+ */
+void sign_tx_start_transaction(void);
+
+/**
+ * Append a chunk of raw transaction in global context, to be hashed and
+ * parsed by sign_tx_process_chunk().
+ *
+ * @see G_context.tx_info.raw_tx and G_context.tx_info.deferred_sw.
+ *
+ * @param[in,out] cdata
+ *   Command data with a part of the raw transaction serialized.
+ *
+ * @return SW_OK if the chunk is appended, deferred error of the previous
+ * chunk or error status word otherwise.
+ *
+ */
+uint16_t sign_tx_append_chunk(buffer_t *cdata);
+
+/**
+ * Hash and parse the chunk appended by sign_tx_append_chunk(), the
+ * message hash is final after the last chunk.
+ *
+ * @see G_context.tx_info.parser and G_context.tx_info.message_hash.
+ *
+ * @param[in] more
+ *   Whether more APDU chunk to be received or not.
+ *
+ * @return SW_OK if the chunk is accepted (and the transaction fully parsed if
+ * it is the last chunk), error status word otherwise.
+ *
+ */
+uint16_t sign_tx_process_chunk(bool more);
+
+/**
+ * Append a chunk of raw transaction in global context and parse it.
+ *
+ * @see G_context.tx_info.raw_tx and G_context.tx_info.parser.
+ *
+ * @param[in,out] cdata
+ *   Command data with a part of the raw transaction serialized.
+ * @param[in]     more
+ *   Whether more APDU chunk to be received or not.
+ *
+ * @return SW_OK if the chunk is accepted (and the transaction fully parsed if
+ * it is the last chunk), error status word otherwise.
+ *
+ */
+uint16_t sign_tx_receive_chunk(buffer_t *cdata, bool more);
+
 /**
  * Handler for SIGN_TX command. If successfully parse BIP32 path
  * and transaction, sign transaction and send APDU response.
@@ -0,0 +1,187 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // memcmp, explicit_bzero
+
+#include "os.h"
+#include "cx.h"
+
+#include "sign_tx_batch.h"
+#include "sign_tx.h"
+#include "../sw.h"
+#include "../globals.h"
+#include "../crypto.h"
+#include "../address.h"
+#include "../ui/display.h"
+#include "../common/buffer.h"
+#include "../helper/send_response.h"
+#include "../transaction/types.h"
+#include "../transaction/utils.h"
+
+void sign_tx_batch_wipe() {
+    if (G_context.req_type != CONFIRM_BATCH) {
+        return;
+    }
+
+    explicit_bzero(&G_context.batch_info, sizeof(G_context.batch_info));
+    G_context.state = STATE_NONE;
+}
+
+/**
+ * Wipe the batch private key and send an error status word.
+ */
+static int batch_abort(uint16_t sw) {
+    sign_tx_batch_wipe();
+
+    return io_send_sw(sw);
+}
+
+static bool is_aptos_coin(const type_tag_struct_t *coin) {
+    return transaction_utils_is_framework_address(coin->address) &&
+           coin->module_name.len == 10 && memcmp(coin->module_name.bytes, "aptos_coin", 10) == 0 &&
+           coin->name.len == 9 && memcmp(coin->name.bytes, "AptosCoin", 9) == 0 &&
+           coin->type_args_size == 0;
+}
+
+/**
+ * Check that the parsed transaction is an APT transfer from the batch sender
+ * which fits in the limits approved by the user.
+ */
+static bool batch_check_transaction(uint64_t *amount) {
+    const batch_ctx_t *batch = &G_context.batch_info;
+    const transaction_t *tx = &G_context.tx_info.transaction;
+
+    if (tx->tx_variant != TX_RAW || tx->payload_variant != PAYLOAD_ENTRY_FUNCTION ||
+        memcmp(tx->sender, batch->sender, ADDRESS_LEN) != 0) {
+        return false;
+    }
+
+    // all transactions of the batch must target the chain of the first one
+    if (batch->tx_signed > 0 && tx->chain_id != batch->chain_id) {
+        return false;
+    }
+
+    const entry_function_payload_t *function = &tx->payload.entry_function;
+    switch (function->known_type) {
+        case FUNC_APTOS_ACCOUNT_TRANSFER:
+            *amount = function->args.transfer.amount;
+            break;
+        case FUNC_COIN_TRANSFER:
+        case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
+            if (!is_aptos_coin(&function->args.coin_transfer.ty_coin)) {
+                return false;
+            }
+            *amount = function->args.coin_transfer.amount;
+            break;
+        default:
+            return false;
+    }
+
+    if (tx->gas_unit_price != 0 && tx->max_gas_amount > batch->max_gas_fee / tx->gas_unit_price) {
+        return false;
+    }
+
+    return batch->tx_signed < batch->tx_count && *amount <= batch->remaining_amount;
+}
+
+void sign_tx_batch_derive_key() {
+    cx_ecfp_private_key_t private_key = {0};
+    uint8_t chain_code[32] = {0};
+
+    crypto_derive_private_key(&private_key,
+                              chain_code,
+                              G_context.bip32_path,
+                              G_context.bip32_path_len);
+    memmove(G_context.batch_info.raw_private_key,
+            private_key.d,
+            sizeof(G_context.batch_info.raw_private_key));
+    explicit_bzero(&private_key, sizeof(private_key));
+}
+
+int handler_sign_tx_batch(buffer_t *cdata, uint8_t chunk, bool more) {
+    if (chunk == 0) {  // first APDU, parse BIP32 path and batch limits
+        explicit_bzero(&G_context, sizeof(G_context));
+        G_context.req_type = CONFIRM_BATCH;
+        G_context.state = STATE_NONE;
+
+        batch_ctx_t *batch = &G_context.batch_info;
+        if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
+            !buffer_read_bip32_path(cdata,
+                                    G_context.bip32_path,
+                                    (size_t) G_context.bip32_path_len) ||
+            !buffer_read_u32(cdata, &batch->tx_count, BE) ||
+            !buffer_read_u64(cdata, &batch->total_amount, BE) ||
+            !buffer_read_u64(cdata, &batch->max_gas_fee, BE) || batch->tx_count == 0) {
+            return io_send_sw(SW_WRONG_DATA_LENGTH);
+        }
+        batch->remaining_amount = batch->total_amount;
+
+        // only the public key is needed for review, the private key is
+        // derived once the user approves the batch
+        uint8_t raw_public_key[32] = {0};
+        uint8_t chain_code[32] = {0};
+        if (crypto_get_public_key(G_context.bip32_path,
+                                  G_context.bip32_path_len,
+                                  raw_public_key,
+                                  chain_code) < 0) {
+            return io_send_sw(SW_WRONG_DATA_LENGTH);
+        }
+        if (!address_from_pubkey(raw_public_key, batch->sender, sizeof(batch->sender))) {
+            return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
+        }
+
+        return ui_display_batch();
+    }
+
+    if (G_context.req_type != CONFIRM_BATCH || G_context.state != STATE_APPROVED) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    if (chunk == 1) {  // first APDU of the next transaction of the batch
+        sign_tx_start_transaction();
+    }
+
+    uint16_t sw = sign_tx_receive_chunk(cdata, more);
+    if (sw != SW_OK) {
+        return batch_abort(sw);
+    }
+    if (more) {
+        return io_send_sw(SW_OK);
+    }
+
+    // last APDU of the transaction, let's check and sign it
+    uint64_t amount = 0;
+    if (!batch_check_transaction(&amount)) {
+        return batch_abort(SW_BATCH_MISMATCH);
+    }
+
+    if (crypto_sign_message_with_key(G_context.batch_info.raw_private_key) < 0) {
+        return batch_abort(SW_SIGNATURE_FAIL);
+    }
+
+    G_context.batch_info.chain_id = G_context.tx_info.transaction.chain_id;
+    G_context.batch_info.remaining_amount -= amount;
+    if (++G_context.batch_info.tx_signed == G_context.batch_info.tx_count) {
+        // whole batch signed, the private key is not needed anymore
+        sign_tx_batch_wipe();
+    }
+
+    return helper_send_response_sig();
+}
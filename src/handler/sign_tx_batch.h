@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "../common/buffer.h"
+
+/**
+ * Wipe the private key of the batch in progress, if any, and go back to
+ * the initial state. Called when the batch completes or aborts, when the
+ * device is locked and when the application exits.
+ *
+ */
+void sign_tx_batch_wipe(void);
+
+/**
+ * Derive the private key of the batch once, after the user approved it.
+ *
+ * @see G_context.bip32_path, G_context.batch_info.
+ *
+ * @throw INVALID_PARAMETER
+ *
+ */
+void sign_tx_batch_derive_key(void);
+
+/**
+ * Handler for SIGN_TX_BATCH command. The first APDU carries the BIP32 path
+ * and the batch limits approved by the user, the private key is then derived
+ * once upon approval and each transaction of the batch is parsed, checked against the
+ * approved limits and signed without further user interaction.
+ *
+ * @see G_context.bip32_path, G_context.batch_info and G_context.tx_info.
+ *
+ * @param[in,out] cdata
+ *   Command data with either BIP32 path and batch limits or raw transaction serialized.
+ * @param[in]     chunk
+ *   Index number of the APDU chunk, 1 starts a new transaction of the batch.
+ * @param[in]     more
+ *   Whether more APDU chunk to be received or not.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_batch(buffer_t *cdata, uint8_t chunk, bool more);
@@ -26,7 +26,7 @@
 #include "common/buffer.h"
 
 int helper_send_response_pubkey() {
-    uint8_t resp[1 + 1 + PUBKEY_LEN + 1 + CHAINCODE_LEN] = {0};
+    uint8_t resp[1 + 1 + PUBKEY_LEN + 1 + CHAINCODE_LEN + 1 + ADDRESS_LEN] = {0};
     size_t offset = 0;
 
     resp[offset++] = PUBKEY_LEN + 1;
@@ -36,17 +36,25 @@ int helper_send_response_pubkey() {
     resp[offset++] = CHAINCODE_LEN;
     memmove(resp + offset, G_context.pk_info.chain_code, CHAINCODE_LEN);
     offset += CHAINCODE_LEN;
+    if (G_context.pk_info.with_address) {
+        resp[offset++] = ADDRESS_LEN;
+        memmove(resp + offset, G_context.pk_info.address, ADDRESS_LEN);
+        offset += ADDRESS_LEN;
+    }
 
     return io_send_response(&(const buffer_t){.ptr = resp, .size = offset, .offset = 0}, SW_OK);
 }
 
 int helper_send_response_sig() {
-    uint8_t resp[1 + MAX_DER_SIG_LEN] = {0};
+    uint8_t resp[1 + MAX_DER_SIG_LEN + 1 + MESSAGE_HASH_LEN] = {0};
     size_t offset = 0;
 
     resp[offset++] = G_context.tx_info.signature_len;
     memmove(resp + offset, G_context.tx_info.signature, G_context.tx_info.signature_len);
     offset += G_context.tx_info.signature_len;
+    resp[offset++] = MESSAGE_HASH_LEN;
+    memmove(resp + offset, G_context.tx_info.message_hash, MESSAGE_HASH_LEN);
+    offset += MESSAGE_HASH_LEN;
 
     return io_send_response(&(const buffer_t){.ptr = resp, .size = offset, .offset = 0}, SW_OK);
 }
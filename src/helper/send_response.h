@@ -19,7 +19,11 @@
  * response = PUBKEY_LEN (1) ||
  *            G_context.pk_info.public_key (PUBKEY_LEN) ||
  *            CHAINCODE_LEN (1) ||
- *            G_context.pk_info.chain_code (CHAINCODE_LEN)
+ *            G_context.pk_info.chain_code (CHAINCODE_LEN) ||
+ *            ADDRESS_LEN (1) ||
+ *            G_context.pk_info.address (ADDRESS_LEN)
+ *
+ * The address is only sent if G_context.pk_info.with_address is set.
  *
  * @return zero or positive integer if success, -1 otherwise.
  *
@@ -27,12 +31,12 @@
 int helper_send_response_pubkey(void);
 
 /**
- * Helper to send APDU response with signature and v (parity of
- * y-coordinate of R).
+ * Helper to send APDU response with signature and message hash.
  *
  * response = G_context.tx_info.signature_len (1) ||
  *            G_context.tx_info.signature (G_context.tx_info.signature_len) ||
- *            G_context.tx_info.v (1)
+ *            MESSAGE_HASH_LEN (1) ||
+ *            G_context.tx_info.message_hash (MESSAGE_HASH_LEN)
  *
  * @return zero or positive integer if success, -1 otherwise.
  *
@@ -22,10 +22,22 @@
 
 #include "io.h"
 #include "globals.h"
+#include "constants.h"
+#include "offsets.h"
 #include "sw.h"
+#include "crypto.h"
+#include "profiling.h"
+#include "handler/sign_tx_batch.h"
 #include "common/buffer.h"
 #include "common/write.h"
 
+// extended APDUs are received when the transport buffer has room for more than
+// 255 bytes of command data, it must then hold the largest one accepted
+#if IO_APDU_BUFFER_SIZE > OFFSET_CDATA + 255
+_Static_assert(IO_APDU_BUFFER_SIZE >= OFFSET_EXT_CDATA + MAX_EXT_LC,
+               "IO_APDU_BUFFER_SIZE too small for extended APDUs");
+#endif
+
 void io_seproxyhal_display(const bagl_element_t *element) {
     io_seproxyhal_display_default((bagl_element_t *) element);
 }
@@ -46,6 +58,14 @@ uint8_t io_event(uint8_t channel __attribute__((unused))) {
             UX_DISPLAYED_EVENT({});
             break;
         case SEPROXYHAL_TAG_TICKER_EVENT:
+#ifdef HAVE_PROFILING
+            profiling_tick();
+#endif
+            // drop cached public key and batch private key as soon as the device is locked
+            if (os_global_pin_is_validated() != BOLOS_UX_OK) {
+                crypto_clear_public_key_cache();
+                sign_tx_batch_wipe();
+            }
             UX_TICKER_EVENT(G_io_seproxyhal_spi_buffer, {});
             break;
         default:
@@ -160,3 +180,19 @@ int io_send_response(const buffer_t *rdata, uint16_t sw) {
 int io_send_sw(uint16_t sw) {
     return io_send_response(NULL, sw);
 }
+
+int io_send_sw_early(uint16_t sw) {
+    if (G_io_state != RECEIVED) {
+        return -1;
+    }
+
+    PRINTF("<= SW=%04X | RData= (early)\n", sw);
+    write_u16_be(G_io_apdu_buffer, 0, sw);
+    io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
+
+    // nothing left to send, next io_recv_command() only receives
+    G_output_len = 0;
+    G_io_state = READY;
+
+    return 0;
+}
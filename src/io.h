@@ -61,3 +61,17 @@ int io_send_response(const buffer_t *rdata, uint16_t sw);
  *
  */
 int io_send_sw(uint16_t sw);
+
+/**
+ * Send APDU response (only status word) right away, before the command
+ * is processed, so that the host can send the next command meanwhile.
+ * G_io_apdu_buffer is overwritten: command data must be copied before.
+ * No other response must be sent for the command.
+ *
+ * @param[in] sw
+ *   Status word of APDU response.
+ *
+ * @return zero if success, -1 otherwise.
+ *
+ */
+int io_send_sw_early(uint16_t sw);
@@ -25,14 +25,22 @@
 #include "globals.h"
 #include "io.h"
 #include "sw.h"
+#include "crypto.h"
+#include "profiling.h"
+#include "settings.h"
 #include "ui/menu.h"
 #include "apdu/parser.h"
 #include "apdu/dispatcher.h"
+#include "handler/sign_tx_batch.h"
 
 uint8_t G_io_seproxyhal_spi_buffer[IO_SEPROXYHAL_BUFFER_SIZE_B];
 ux_state_t G_ux;
 bolos_ux_params_t G_ux_params;
 global_ctx_t G_context;
+#ifdef HAVE_ABI_DESCRIPTORS
+abi_cache_t G_abi_cache;
+#endif
+const internal_storage_t N_storage_real;
 
 /**
  * Handle APDU command received and send back APDU response using handlers.
@@ -48,6 +56,14 @@ void app_main() {
     // Reset context
     explicit_bzero(&G_context, sizeof(G_context));
 
+#ifdef HAVE_ABI_DESCRIPTORS
+    abi_cache_init(&G_abi_cache);
+#endif
+
+#ifdef HAVE_PROFILING
+    profiling_init();
+#endif
+
     for (;;) {
         BEGIN_TRY {
             TRY {
@@ -68,7 +84,7 @@ void app_main() {
                     continue;
                 }
 
-                PRINTF("=> CLA=%02X | INS=%02X | P1=%02X | P2=%02X | Lc=%02X | CData=%.*H\n",
+                PRINTF("=> CLA=%02X | INS=%02X | P1=%02X | P2=%02X | Lc=%04X | CData=%.*H\n",
                        cmd.cla,
                        cmd.ins,
                        cmd.p1,
@@ -100,6 +116,9 @@ void app_main() {
  * Exit the application and go back to the dashboard.
  */
 void app_exit() {
+    crypto_clear_public_key_cache();
+    sign_tx_batch_wipe();
+
     BEGIN_TRY_L(exit) {
         TRY_L(exit) {
             os_sched_exit(-1);
@@ -114,7 +133,9 @@ void app_exit() {
  * Main loop to setup USB, Bluetooth, UI and launch app_main().
  */
 __attribute__((section(".boot"))) int main() {
+#ifndef NATIVE
     __asm volatile("cpsie i");
+#endif  // NATIVE
 
     os_boot();
 
@@ -133,6 +154,8 @@ __attribute__((section(".boot"))) int main() {
                 USB_power(0);
                 USB_power(1);
 
+                settings_init();
+
                 ui_menu_main();
 
 #ifdef HAVE_BLE
@@ -24,3 +24,11 @@
  * Offset of command data.
  */
 #define OFFSET_CDATA 5
+/**
+ * Offset of command data length of extended APDU (2 bytes after a 0x00 byte).
+ */
+#define OFFSET_EXT_LC 5
+/**
+ * Offset of command data of extended APDU.
+ */
+#define OFFSET_EXT_CDATA 7
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#ifdef HAVE_PROFILING
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+
+#include "profiling.h"
+#include "globals.h"
+
+/**
+ * Bounds of the stack, defined by the linker script of the SDK.
+ */
+extern uint32_t _stack;
+extern uint32_t _estack;
+
+/**
+ * Pattern painted on the unused part of the stack.
+ */
+#define STACK_PAINT 0xA5A5A5A5
+
+/**
+ * Bytes kept unpainted below the stack frame of profiling_init().
+ */
+#define STACK_PAINT_MARGIN 64
+
+/**
+ * Ticker events received since the application started. BOLOS doesn't
+ * expose a cycle counter to applications, the ticker (100 ms) is the
+ * only time base available both on devices and on Speculos.
+ */
+static uint32_t s_ticks;
+
+void profiling_init() {
+    volatile uint32_t *p = &_stack;
+    const uint8_t *sp = (const uint8_t *) __builtin_frame_address(0) - STACK_PAINT_MARGIN;
+
+    s_ticks = 0;
+    while ((const uint8_t *) p < sp) {
+        *p++ = STACK_PAINT;
+    }
+}
+
+void profiling_tick() {
+    s_ticks++;
+}
+
+uint16_t profiling_stack_used() {
+    const uint32_t *p = &_stack;
+
+    while (p < &_estack && *p == STACK_PAINT) {
+        p++;
+    }
+
+    return (uint16_t) ((const uint8_t *) &_estack - (const uint8_t *) p);
+}
+
+uint16_t profiling_stack_size() {
+    return (uint16_t) ((const uint8_t *) &_estack - (const uint8_t *) &_stack);
+}
+
+void profiling_record(profile_stage_e stage, bool end) {
+    profile_ctx_t *profile = &G_context.profile;
+    profile_record_t *record = &profile->records[profile->next];
+
+    record->stage = (uint8_t) stage;
+    record->end = end ? 1 : 0;
+    record->stack_used = profiling_stack_used();
+    record->ticks = s_ticks;
+
+    profile->next = (profile->next + 1) % PROFILE_RECORDS_LEN;
+    if (profile->count < PROFILE_RECORDS_LEN) {
+        profile->count++;
+    }
+}
+
+#endif
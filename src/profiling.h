@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "types.h"
+
+#ifdef HAVE_PROFILING
+
+/**
+ * Fill the unused part of the stack with a known pattern to measure its
+ * high-water mark later on.
+ */
+void profiling_init(void);
+
+/**
+ * Count a ticker event, the time base of the records: a stage shorter than
+ * the 100 ms period usually begins and ends on the same tick.
+ */
+void profiling_tick(void);
+
+/**
+ * Stack high-water mark since profiling_init().
+ *
+ * @return number of bytes of stack used.
+ *
+ */
+uint16_t profiling_stack_used(void);
+
+/**
+ * Size of the stack.
+ *
+ * @return number of bytes of stack.
+ *
+ */
+uint16_t profiling_stack_size(void);
+
+/**
+ * Append record to the ring buffer of G_context.
+ *
+ * @param[in] stage
+ *   Profiled stage.
+ * @param[in] end
+ *   Whether the stage ends or begins.
+ *
+ */
+void profiling_record(profile_stage_e stage, bool end);
+
+#define PROFILE_BEGIN(stage) profiling_record(stage, false)
+#define PROFILE_END(stage)   profiling_record(stage, true)
+
+#else
+
+#define PROFILE_BEGIN(stage)
+#define PROFILE_END(stage)
+
+#endif
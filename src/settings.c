@@ -0,0 +1,90 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+
+#include "os.h"
+
+#include "settings.h"
+#include "globals.h"
+
+/**
+ * Write a field of N_storage only if its value changes, flash pages wear
+ * out with erase cycles and unchanged settings would erase them for nothing.
+ */
+static void settings_write(volatile void *field, const void *value, size_t len) {
+    const volatile uint8_t *current = field;
+    const uint8_t *bytes = value;
+    size_t i = 0;
+
+    while (i < len && current[i] == bytes[i]) {
+        i++;
+    }
+    if (i == len) {
+        return;
+    }
+
+    nvm_write((void *) field, (void *) value, len);
+}
+
+void settings_init() {
+    internal_storage_t storage = {0};
+
+    if (N_storage.initialized == 0x01 && N_storage.version == SETTINGS_VERSION) {
+        return;
+    }
+
+    // first start or another layout: every setting gets its default
+    storage.initialized = 0x01;
+    storage.version = SETTINGS_VERSION;
+    storage.blind_signing = 0x00;
+    storage.expert_mode = 0x00;
+    storage.account_index = 0;
+
+    nvm_write((void *) &N_storage, (void *) &storage, sizeof(internal_storage_t));
+}
+
+void settings_set_blind_signing(bool enabled) {
+    const uint8_t value = enabled ? 0x01 : 0x00;
+
+    settings_write(&N_storage.blind_signing, &value, sizeof(value));
+}
+
+void settings_set_expert_mode(bool enabled) {
+    const uint8_t value = enabled ? 0x01 : 0x00;
+
+    settings_write(&N_storage.expert_mode, &value, sizeof(value));
+}
+
+void settings_set_account_index(uint32_t account_index) {
+    settings_write(&N_storage.account_index, &account_index, sizeof(account_index));
+}
+
+uint8_t settings_flags() {
+    uint8_t flags = 0;
+
+    if (N_storage.blind_signing) {
+        flags |= SETTINGS_FLAG_BLIND_SIGNING;
+    }
+    if (N_storage.expert_mode) {
+        flags |= SETTINGS_FLAG_EXPERT_MODE;
+    }
+
+    return flags;
+}
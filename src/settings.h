@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+/**
+ * Bits of the flags byte of GET_SETTINGS response.
+ */
+#define SETTINGS_FLAG_BLIND_SIGNING 0x01
+#define SETTINGS_FLAG_EXPERT_MODE   0x02
+
+/**
+ * Initialize settings in NVM with their defaults on first launch after
+ * install, or when their layout is not SETTINGS_VERSION.
+ */
+void settings_init(void);
+
+/**
+ * Enable or disable blind signing of unknown entry functions.
+ *
+ * @param[in] enabled
+ *   New value of the setting.
+ *
+ */
+void settings_set_blind_signing(bool enabled);
+
+/**
+ * Enable or disable expert display mode.
+ *
+ * @param[in] enabled
+ *   New value of the setting.
+ *
+ */
+void settings_set_expert_mode(bool enabled);
+
+/**
+ * Remember the account index of the last address confirmed on screen.
+ *
+ * @param[in] account_index
+ *   Account index, hardened bit included.
+ *
+ */
+void settings_set_account_index(uint32_t account_index);
+
+/**
+ * Flags of the settings as sent in GET_SETTINGS response.
+ *
+ * @return combination of SETTINGS_FLAG_* bits.
+ *
+ */
+uint8_t settings_flags(void);
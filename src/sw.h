@@ -60,3 +60,19 @@
  * Status word for signature fail.
  */
 #define SW_SIGNATURE_FAIL 0xB008
+/**
+ * Status word for transaction not matching the approved batch.
+ */
+#define SW_BATCH_MISMATCH 0xB009
+/**
+ * Status word for invalid ABI descriptor.
+ */
+#define SW_ABI_DESCRIPTOR_FAIL 0xB00A
+/**
+ * Status word for ABI descriptor not signed by the trusted key.
+ */
+#define SW_ABI_SIGNATURE_FAIL 0xB00B
+/**
+ * Status word for unknown entry function with blind signing disabled.
+ */
+#define SW_BLIND_SIGNING_DISABLED 0xB00C
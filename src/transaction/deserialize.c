@@ -6,91 +6,297 @@
 #include "../bcs/init.h"
 #include "../bcs/decoder.h"
 
-parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (buf->size > MAX_TX_LEN) {
-        return WRONG_LENGTH_ERROR;
-    }
+void transaction_parser_init(tx_parser_state_t *state, transaction_t *tx) {
+    state->step = TX_STEP_VARIANT;
+    state->offset = 0;
+    state->remaining = 0;
     transaction_init(tx);
+}
 
-    parser_status_e tx_variant_parsing_status = tx_variant_deserialize(buf, tx);
-    if (tx_variant_parsing_status != PARSING_OK) {
-        return tx_variant_parsing_status;
-    }
+parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx) {
+    tx_parser_state_t state;
 
-    switch (tx->tx_variant) {
-        case TX_RAW:
-            return tx_raw_deserialize(buf, tx);
-        case TX_RAW_WITH_DATA:
-        case TX_MESSAGE:
-        default:
-            break;
-    }
+    transaction_parser_init(&state, tx);
 
-    return PARSING_OK;
+    return transaction_deserialize_chunk(&state, buf, tx, false);
 }
 
-parser_status_e tx_raw_deserialize(buffer_t *buf, transaction_t *tx) {
-    if (tx->tx_variant != TX_RAW) {
-        return TX_VARIANT_UNDEFINED_ERROR;
+parser_status_e transaction_deserialize_chunk(tx_parser_state_t *state,
+                                              buffer_t *buf,
+                                              transaction_t *tx,
+                                              bool more) {
+    if (buf->size > MAX_TX_LEN) {
+        return WRONG_LENGTH_ERROR;
     }
 
-    // read sender address
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &tx->sender, ADDRESS_LEN)) {
-        return SENDER_READ_ERROR;
-    }
-    // read sequence
-    if (!bcs_read_u64(buf, &tx->sequence)) {
-        return SEQUENCE_READ_ERROR;
-    }
+    while (state->step != TX_STEP_DONE) {
+        buf->offset = state->offset;
 
-    const size_t buf_footer_begin = buf->size - TX_FOOTER_LEN;
-    buffer_t buf_footer = {.ptr = buf->ptr, .size = buf->size, .offset = buf_footer_begin};
-    // read max_gas_amount
-    if (!bcs_read_u64(&buf_footer, &tx->max_gas_amount)) {
-        return MAX_GAS_READ_ERROR;
-    }
-    // read gas_unit_price
-    if (!bcs_read_u64(&buf_footer, &tx->gas_unit_price)) {
-        return GAS_UNIT_PRICE_READ_ERROR;
-    }
-    // read expiration_timestamp_secs
-    if (!bcs_read_u64(&buf_footer, &tx->expiration_timestamp_secs)) {
-        return EXPIRATION_READ_ERROR;
-    }
-    // read chain_id
-    if (!bcs_read_u8(&buf_footer, &tx->chain_id)) {
-        return CHAIN_ID_READ_ERROR;
-    }
+        const tx_parser_step_e step = state->step;
+        const size_t arena_used = tx->arena.used;
+        parser_status_e status = tx_step_deserialize(state, buf, tx, more);
+        if (status == PARSING_INCOMPLETE || (status != PARSING_OK && more)) {
+            // the step is decoded again from its first byte with the next chunk,
+            // so a field cut by the end of this chunk is resumed transparently
+            buf->offset = state->offset;
+            tx->arena.used = arena_used;
+            return more ? PARSING_INCOMPLETE : status;
+        }
+        if (status != PARSING_OK) {
+            return status;
+        }
 
-    // read payload_variant
-    uint32_t payload_variant = PAYLOAD_UNDEFINED;
-    if (!bcs_read_u32_from_uleb128(buf, &payload_variant)) {
-        return PAYLOAD_VARIANT_READ_ERROR;
+        state->offset = buf->offset;
+        if (state->step == step && state->remaining == 0) {
+            // step consumed everything received so far and waits for more data
+            return PARSING_INCOMPLETE;
+        }
     }
-    if (payload_variant != PAYLOAD_ENTRY_FUNCTION && payload_variant != PAYLOAD_SCRIPT) {
-        return PAYLOAD_UNDEFINED_ERROR;
+
+    buf->offset = state->offset;
+    if (buf->offset != buf->size) {
+        return WRONG_LENGTH_ERROR;
     }
-    tx->payload_variant = payload_variant;
 
-    parser_status_e payload_parsing_status = 0;
-    switch (tx->payload_variant) {
-        case PAYLOAD_ENTRY_FUNCTION:
-            payload_parsing_status = entry_function_payload_deserialize(buf, tx);
-            if (payload_parsing_status != PARSING_OK) {
-                return payload_parsing_status;
+    return more ? PARSING_INCOMPLETE : PARSING_OK;
+}
+
+parser_status_e tx_step_deserialize(tx_parser_state_t *state,
+                                    buffer_t *buf,
+                                    transaction_t *tx,
+                                    bool more) {
+    parser_status_e status = PARSING_OK;
+    uint32_t size = 0;
+    type_tag_t *ty_args = NULL;
+
+    switch (state->step) {
+        case TX_STEP_VARIANT:
+            if (more && !buffer_can_read(buf, TX_HASHED_PREFIX_LEN)) {
+                return PARSING_INCOMPLETE;
+            }
+            status = tx_variant_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            switch (tx->tx_variant) {
+                case TX_RAW:
+                    state->step = TX_STEP_SENDER;
+                    break;
+                case TX_RAW_WITH_DATA:
+                    state->step = TX_STEP_RAW_WITH_DATA;
+                    break;
+                case TX_MESSAGE:
+                default:
+                    state->step = TX_STEP_MESSAGE;
+                    break;
+            }
+            return PARSING_OK;
+        case TX_STEP_MESSAGE:
+            if (!transaction_utils_check_encoding(buf->ptr + buf->offset,
+                                                  buf->size - buf->offset)) {
+                return TX_VARIANT_UNDEFINED_ERROR;
+            }
+            tx->message.bytes = (uint8_t *) buf->ptr;
+            tx->message.len = buf->size;
+            buf->offset = buf->size;
+            if (!more) {
+                state->step = TX_STEP_DONE;
+            }
+            return PARSING_OK;
+        case TX_STEP_RAW_WITH_DATA:
+            // read RawTransactionWithData variant, followed by RawTransaction
+            if (!bcs_read_u32_from_uleb128(buf, &size)) {
+                return WITH_DATA_VARIANT_READ_ERROR;
+            }
+            if (size != TX_WITH_DATA_MULTI_AGENT && size != TX_WITH_DATA_FEE_PAYER) {
+                return WITH_DATA_VARIANT_UNDEFINED_ERROR;
+            }
+            tx->with_data_variant = size;
+            state->step = TX_STEP_SENDER;
+            return PARSING_OK;
+        case TX_STEP_SENDER:
+            // read sender address
+            if (!bcs_read_ptr_to_fixed_bytes(buf, &tx->sender, ADDRESS_LEN)) {
+                return SENDER_READ_ERROR;
+            }
+            state->step = TX_STEP_SEQUENCE;
+            return PARSING_OK;
+        case TX_STEP_SEQUENCE:
+            // read sequence
+            if (!bcs_read_u64(buf, &tx->sequence)) {
+                return SEQUENCE_READ_ERROR;
             }
-            if (tx->payload.entry_function.known_type == FUNC_APTOS_ACCOUNT_TRANSFER) {
-                return (buf->offset == buf_footer_begin) ? PARSING_OK : WRONG_LENGTH_ERROR;
+            state->step = TX_STEP_PAYLOAD_VARIANT;
+            return PARSING_OK;
+        case TX_STEP_PAYLOAD_VARIANT:
+            status = payload_variant_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            if (tx->payload_variant == PAYLOAD_SCRIPT) {
+                script_payload_init(&tx->payload.script);
+                state->step = TX_STEP_SCRIPT_CODE;
+            } else {
+                state->step = TX_STEP_ENTRY_FUNCTION;
+            }
+            return PARSING_OK;
+        case TX_STEP_ENTRY_FUNCTION:
+            status = entry_function_payload_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            state->step = (tx->payload.entry_function.known_type == FUNC_UNKNOWN)
+                              ? TX_STEP_TYPE_ARGS_SIZE
+                              : TX_STEP_KNOWN_FUNCTION;
+            return PARSING_OK;
+        case TX_STEP_KNOWN_FUNCTION:
+            status = known_function_args_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            state->step = TX_STEP_FOOTER;
+            return PARSING_OK;
+        case TX_STEP_SCRIPT_CODE:
+            // read script bytecode
+            if (!bcs_read_u32_from_uleb128(buf, &size) ||
+                !bcs_read_ptr_to_fixed_bytes(buf, &tx->payload.script.code.bytes, size)) {
+                return SCRIPT_CODE_READ_ERROR;
+            }
+            tx->payload.script.code.len = size;
+            state->step = TX_STEP_TYPE_ARGS_SIZE;
+            return PARSING_OK;
+        case TX_STEP_TYPE_ARGS_SIZE:
+            // read type args size
+            if (!bcs_read_u32_from_uleb128(buf, &size)) {
+                return TYPE_ARGS_SIZE_READ_ERROR;
+            }
+            if (size > 0) {
+                // every type arg takes at least one byte
+                if (!buffer_can_read(buf, size)) {
+                    return TYPE_ARGS_SIZE_READ_ERROR;
+                }
+                ty_args = bcs_arena_alloc(&tx->arena, size * sizeof(type_tag_t));
+                if (ty_args == NULL) {
+                    return TYPE_TAG_ARENA_FULL_ERROR;
+                }
+            }
+            if (tx->payload_variant == PAYLOAD_SCRIPT) {
+                tx->payload.script.ty_size = size;
+                tx->payload.script.ty_args = ty_args;
+            } else {
+                tx->payload.entry_function.args.ty_size = size;
+                tx->payload.entry_function.args.raw.ty_args = ty_args;
+            }
+            state->remaining = size;
+            state->step = (size > 0) ? TX_STEP_TYPE_ARG : TX_STEP_ARGS_SIZE;
+            return PARSING_OK;
+        case TX_STEP_TYPE_ARG:
+            // decode type arg, nested vector and struct type tags go to the arena
+            if (tx->payload_variant == PAYLOAD_SCRIPT) {
+                size = tx->payload.script.ty_size;
+                ty_args = tx->payload.script.ty_args;
+            } else {
+                size = tx->payload.entry_function.args.ty_size;
+                ty_args = tx->payload.entry_function.args.raw.ty_args;
+            }
+            if (!bcs_read_type_tag(buf, &tx->arena, &ty_args[size - state->remaining])) {
+                return TYPE_TAG_READ_ERROR;
+            }
+            if (--state->remaining == 0) {
+                state->step = TX_STEP_ARGS_SIZE;
+            }
+            return PARSING_OK;
+        case TX_STEP_ARGS_SIZE:
+            // read args size
+            if (!bcs_read_u32_from_uleb128(buf, &size)) {
+                return ARGS_SIZE_READ_ERROR;
+            }
+            if (tx->payload_variant == PAYLOAD_SCRIPT) {
+                // keep a view on each typed script argument
+                if (size > 0) {
+                    // every script argument takes at least one byte
+                    if (!buffer_can_read(buf, size)) {
+                        return ARGS_SIZE_READ_ERROR;
+                    }
+                    tx->payload.script.args =
+                        bcs_arena_alloc(&tx->arena, size * sizeof(fixed_bytes_t));
+                    if (tx->payload.script.args == NULL) {
+                        return ARGS_ARENA_FULL_ERROR;
+                    }
+                }
+                tx->payload.script.args_size = size;
+            } else {
+                // keep a view on each argument when the arena has room for it, the
+                // arguments are only decoded for review with a descriptor
+                tx->payload.entry_function.args.raw.args = NULL;
+                if (size > 0 && size <= sizeof(tx->arena.buf) / sizeof(fixed_bytes_t)) {
+                    tx->payload.entry_function.args.raw.args =
+                        bcs_arena_alloc(&tx->arena, size * sizeof(fixed_bytes_t));
+                }
+                tx->payload.entry_function.args.args_size = size;
+            }
+            state->remaining = size;
+            state->step = (size > 0) ? TX_STEP_ARG : TX_STEP_FOOTER;
+            return PARSING_OK;
+        case TX_STEP_ARG:
+            if (tx->payload_variant == PAYLOAD_SCRIPT) {
+                // typed script argument, variant included
+                fixed_bytes_t *arg =
+                    &tx->payload.script.args[tx->payload.script.args_size - state->remaining];
+                arg->bytes = (uint8_t *) buf->ptr + buf->offset;
+                if (!bcs_skip_script_arg(buf)) {
+                    return ARG_READ_ERROR;
+                }
+                arg->len = buf->ptr + buf->offset - arg->bytes;
+            } else {
+                // BCS encoded bytes of entry function argument, length prefix excluded
+                fixed_bytes_t *args = tx->payload.entry_function.args.raw.args;
+                uint8_t *bytes = NULL;
+                if (!bcs_read_u32_from_uleb128(buf, &size) ||
+                    !bcs_read_ptr_to_fixed_bytes(buf, &bytes, size)) {
+                    return ARG_READ_ERROR;
+                }
+                if (args != NULL) {
+                    fixed_bytes_t *arg =
+                        &args[tx->payload.entry_function.args.args_size - state->remaining];
+                    arg->bytes = bytes;
+                    arg->len = size;
+                }
+            }
+            if (--state->remaining == 0) {
+                state->step = TX_STEP_FOOTER;
+            }
+            return PARSING_OK;
+        case TX_STEP_FOOTER:
+            status = tx_footer_deserialize(buf, tx);
+            if (status != PARSING_OK) {
+                return status;
+            }
+            state->step =
+                (tx->tx_variant == TX_RAW_WITH_DATA) ? TX_STEP_SECONDARY_SIGNERS : TX_STEP_DONE;
+            return PARSING_OK;
+        case TX_STEP_SECONDARY_SIGNERS:
+            // addresses are contiguous in the vector, keep a single view on them
+            if (!bcs_read_u32_from_uleb128(buf, &size) || size > MAX_TX_LEN / ADDRESS_LEN ||
+                !bcs_read_ptr_to_fixed_bytes(buf, &tx->secondary_signers, size * ADDRESS_LEN)) {
+                return SECONDARY_SIGNERS_READ_ERROR;
             }
+            tx->secondary_signers_size = size;
+            state->step = (tx->with_data_variant == TX_WITH_DATA_FEE_PAYER) ? TX_STEP_FEE_PAYER
+                                                                            : TX_STEP_DONE;
             return PARSING_OK;
-        case PAYLOAD_SCRIPT:
-            // TODO: implement script fields parsing
+        case TX_STEP_FEE_PAYER:
+            // read fee payer address
+            if (!bcs_read_ptr_to_fixed_bytes(buf, &tx->fee_payer, ADDRESS_LEN)) {
+                return FEE_PAYER_READ_ERROR;
+            }
+            state->step = TX_STEP_DONE;
+            return PARSING_OK;
+        case TX_STEP_DONE:
             return PARSING_OK;
         default:
-            return PAYLOAD_UNDEFINED_ERROR;
+            return TX_VARIANT_UNDEFINED_ERROR;
     }
-
-    return PARSING_OK;
 }
 
 parser_status_e tx_variant_deserialize(buffer_t *buf, transaction_t *tx) {
@@ -114,13 +320,45 @@ parser_status_e tx_variant_deserialize(buffer_t *buf, transaction_t *tx) {
         }
     }
 
-    if (transaction_utils_check_encoding(buf->ptr, buf->size)) {
-        buf->offset = 0;
-        tx->tx_variant = TX_MESSAGE;
-        return PARSING_OK;
+    // anything else is an ASCII message, its encoding is checked while it is decoded
+    buf->offset = 0;
+    tx->tx_variant = TX_MESSAGE;
+    return PARSING_OK;
+}
+
+parser_status_e payload_variant_deserialize(buffer_t *buf, transaction_t *tx) {
+    // read payload_variant
+    uint32_t payload_variant = PAYLOAD_UNDEFINED;
+    if (!bcs_read_u32_from_uleb128(buf, &payload_variant)) {
+        return PAYLOAD_VARIANT_READ_ERROR;
+    }
+    if (payload_variant != PAYLOAD_ENTRY_FUNCTION && payload_variant != PAYLOAD_SCRIPT) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
+    tx->payload_variant = payload_variant;
 
-    return TX_VARIANT_UNDEFINED_ERROR;
+    return PARSING_OK;
+}
+
+parser_status_e tx_footer_deserialize(buffer_t *buf, transaction_t *tx) {
+    // read max_gas_amount
+    if (!bcs_read_u64(buf, &tx->max_gas_amount)) {
+        return MAX_GAS_READ_ERROR;
+    }
+    // read gas_unit_price
+    if (!bcs_read_u64(buf, &tx->gas_unit_price)) {
+        return GAS_UNIT_PRICE_READ_ERROR;
+    }
+    // read expiration_timestamp_secs
+    if (!bcs_read_u64(buf, &tx->expiration_timestamp_secs)) {
+        return EXPIRATION_READ_ERROR;
+    }
+    // read chain_id
+    if (!bcs_read_u8(buf, &tx->chain_id)) {
+        return CHAIN_ID_READ_ERROR;
+    }
+
+    return PARSING_OK;
 }
 
 parser_status_e entry_function_payload_deserialize(buffer_t *buf, transaction_t *tx) {
@@ -129,82 +367,150 @@ parser_status_e entry_function_payload_deserialize(buffer_t *buf, transaction_t
     }
     entry_function_payload_t *payload = &tx->payload.entry_function;
     entry_function_payload_init(payload);
+    uint32_t len = 0;
 
     // read module id address field
-    if (!bcs_read_fixed_bytes(buf,
-                              (uint8_t *) payload->module_id.address,
-                              sizeof payload->module_id.address)) {
+    if (!bcs_read_ptr_to_fixed_bytes(buf, &payload->module_id.address, ADDRESS_LEN)) {
         return MODULE_ID_ADDR_READ_ERROR;
     }
     // read module_id name len field
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->module_id.name.len)) {
+    if (!bcs_read_u32_from_uleb128(buf, &len)) {
         return MODULE_ID_NAME_LEN_READ_ERROR;
     }
     //  read module_id name bytes field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &payload->module_id.name.bytes,
-                                     payload->module_id.name.len)) {
+    if (!bcs_read_ptr_to_fixed_bytes(buf, &payload->module_id.name.bytes, len)) {
         return MODULE_ID_NAME_BYTES_READ_ERROR;
     }
+    payload->module_id.name.len = len;
     // read function_name len field
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->function_name.len)) {
+    if (!bcs_read_u32_from_uleb128(buf, &len)) {
         return FUNCTION_NAME_LEN_READ_ERROR;
     }
     // read function_name bytes field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &payload->function_name.bytes,
-                                     payload->function_name.len)) {
+    if (!bcs_read_ptr_to_fixed_bytes(buf, &payload->function_name.bytes, len)) {
         return FUNCTION_NAME_BYTES_READ_ERROR;
     }
+    payload->function_name.len = len;
 
     payload->known_type = determine_function_type(tx);
-    switch (payload->known_type) {
-        case FUNC_APTOS_ACCOUNT_TRANSFER:
-            return aptos_account_transfer_function_deserialize(buf, tx);
-        case FUNC_COIN_TRANSFER:
-            return coin_transfer_function_deserialize(buf, tx);
-        default:
-            return PARSING_OK;
-    }
 
     return PARSING_OK;
 }
 
-parser_status_e aptos_account_transfer_function_deserialize(buffer_t *buf, transaction_t *tx) {
+/**
+ * Known 0x1::module::function signature and decoder of its arguments.
+ */
+typedef struct {
+    const char *module_name;
+    size_t module_name_len;
+    const char *function_name;
+    size_t function_name_len;
+    entry_function_known_type_t type;
+    parser_status_e (*args_deserialize)(buffer_t *buf, transaction_t *tx);
+} known_function_t;
+
+#define KNOWN_FUNCTION(module, function, type, args_deserialize) \
+    { module, sizeof(module) - 1, function, sizeof(function) - 1, type, args_deserialize }
+
+// Entry functions of the Aptos framework (0x1) decoded and displayed in clear
+static const known_function_t KNOWN_FUNCTIONS[] = {
+    KNOWN_FUNCTION("aptos_account",
+                   "transfer",
+                   FUNC_APTOS_ACCOUNT_TRANSFER,
+                   aptos_account_transfer_function_deserialize),
+    KNOWN_FUNCTION("aptos_account",
+                   "transfer_coins",
+                   FUNC_APTOS_ACCOUNT_TRANSFER_COINS,
+                   coin_transfer_function_deserialize),
+    KNOWN_FUNCTION("coin", "transfer", FUNC_COIN_TRANSFER, coin_transfer_function_deserialize),
+    KNOWN_FUNCTION("coin", "register", FUNC_COIN_REGISTER, coin_register_function_deserialize),
+    KNOWN_FUNCTION("stake", "add_stake", FUNC_STAKE_ADD_STAKE, stake_function_deserialize),
+    KNOWN_FUNCTION("stake", "unlock", FUNC_STAKE_UNLOCK, stake_function_deserialize),
+    KNOWN_FUNCTION("stake", "withdraw", FUNC_STAKE_WITHDRAW, stake_function_deserialize),
+    KNOWN_FUNCTION("delegation_pool",
+                   "add_stake",
+                   FUNC_DELEGATION_POOL_ADD_STAKE,
+                   delegation_pool_function_deserialize),
+    KNOWN_FUNCTION("delegation_pool",
+                   "unlock",
+                   FUNC_DELEGATION_POOL_UNLOCK,
+                   delegation_pool_function_deserialize),
+    KNOWN_FUNCTION("delegation_pool",
+                   "reactivate_stake",
+                   FUNC_DELEGATION_POOL_REACTIVATE_STAKE,
+                   delegation_pool_function_deserialize),
+    KNOWN_FUNCTION("delegation_pool",
+                   "withdraw",
+                   FUNC_DELEGATION_POOL_WITHDRAW,
+                   delegation_pool_function_deserialize),
+};
+
+#define KNOWN_FUNCTIONS_LEN (sizeof(KNOWN_FUNCTIONS) / sizeof(KNOWN_FUNCTIONS[0]))
+
+parser_status_e known_function_args_deserialize(buffer_t *buf, transaction_t *tx) {
     if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
         return PAYLOAD_UNDEFINED_ERROR;
     }
-    entry_function_payload_t *payload = &tx->payload.entry_function;
-    if (payload->known_type != FUNC_APTOS_ACCOUNT_TRANSFER) {
-        return PAYLOAD_UNDEFINED_ERROR;
+
+    for (size_t i = 0; i < KNOWN_FUNCTIONS_LEN; i++) {
+        if (KNOWN_FUNCTIONS[i].type == tx->payload.entry_function.known_type) {
+            return KNOWN_FUNCTIONS[i].args_deserialize(buf, tx);
+        }
     }
 
+    return PAYLOAD_UNDEFINED_ERROR;
+}
+
+static parser_status_e ty_args_size_deserialize(buffer_t *buf,
+                                                entry_function_payload_t *payload,
+                                                size_t expected) {
+    uint32_t size = 0;
     // read type args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.ty_size)) {
+    if (!bcs_read_u32_from_uleb128(buf, &size)) {
         return TYPE_ARGS_SIZE_READ_ERROR;
     }
-    if (payload->args.ty_size != 0) {
+    if (size != expected) {
         return TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
     }
+    payload->args.ty_size = size;
+
+    return PARSING_OK;
+}
+
+static parser_status_e args_size_deserialize(buffer_t *buf,
+                                             entry_function_payload_t *payload,
+                                             size_t expected) {
+    uint32_t size = 0;
     // read args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.args_size)) {
+    if (!bcs_read_u32_from_uleb128(buf, &size)) {
         return ARGS_SIZE_READ_ERROR;
     }
-    if (payload->args.args_size != 2) {
+    if (size != expected) {
         return ARGS_SIZE_UNEXPECTED_ERROR;
     }
-    uint32_t receiver_len;
-    // read receiver address len
-    if (!bcs_read_u32_from_uleb128(buf, &receiver_len)) {
+    payload->args.args_size = size;
+
+    return PARSING_OK;
+}
+
+static parser_status_e address_arg_deserialize(buffer_t *buf, uint8_t **address) {
+    uint32_t address_len;
+    // read address len
+    if (!bcs_read_u32_from_uleb128(buf, &address_len)) {
         return RECEIVER_ADDR_LEN_READ_ERROR;
     }
-    if (receiver_len != ADDRESS_LEN) {
+    if (address_len != ADDRESS_LEN) {
         return WRONG_ADDRESS_LEN_ERROR;
     }
-    // read receiver address field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &payload->args.transfer.receiver, ADDRESS_LEN)) {
+    // read address field
+    if (!bcs_read_ptr_to_fixed_bytes(buf, address, ADDRESS_LEN)) {
         return RECEIVER_ADDR_READ_ERROR;
     }
+
+    return PARSING_OK;
+}
+
+static parser_status_e amount_arg_deserialize(buffer_t *buf, uint64_t *amount) {
     uint32_t amount_len;
     // read amount len
     if (!bcs_read_u32_from_uleb128(buf, &amount_len)) {
@@ -214,105 +520,148 @@ parser_status_e aptos_account_transfer_function_deserialize(buffer_t *buf, trans
         return WRONG_AMOUNT_LEN_ERROR;
     }
     // read amount field
-    if (!bcs_read_u64(buf, &payload->args.transfer.amount)) {
+    if (!bcs_read_u64(buf, amount)) {
         return AMOUNT_READ_ERROR;
     }
 
     return PARSING_OK;
 }
 
-parser_status_e coin_transfer_function_deserialize(buffer_t *buf, transaction_t *tx) {
+static parser_status_e coin_type_deserialize(buffer_t *buf,
+                                             bcs_arena_t *arena,
+                                             type_tag_struct_t *ty_coin) {
+    uint32_t ty_arg_variant = TYPE_TAG_UNDEFINED;
+    // read type tag variant
+    if (!bcs_read_u32_from_uleb128(buf, &ty_arg_variant)) {
+        return TYPE_TAG_READ_ERROR;
+    }
+    if (ty_arg_variant != TYPE_TAG_STRUCT) {
+        return TYPE_TAG_UNEXPECTED_ERROR;
+    }
+    // read coin struct, generic coins such as LP<X, Y> have their type args in the arena
+    if (!bcs_read_type_tag_struct(buf, arena, ty_coin)) {
+        return TYPE_TAG_READ_ERROR;
+    }
+
+    return PARSING_OK;
+}
+
+parser_status_e aptos_account_transfer_function_deserialize(buffer_t *buf, transaction_t *tx) {
     if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
         return PAYLOAD_UNDEFINED_ERROR;
     }
     entry_function_payload_t *payload = &tx->payload.entry_function;
-    if (payload->known_type != FUNC_COIN_TRANSFER) {
+    if (payload->known_type != FUNC_APTOS_ACCOUNT_TRANSFER) {
         return PAYLOAD_UNDEFINED_ERROR;
     }
 
-    // read type args size field
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.ty_size)) {
-        return TYPE_ARGS_SIZE_READ_ERROR;
+    parser_status_e status = ty_args_size_deserialize(buf, payload, 0);
+    if (status == PARSING_OK) {
+        status = args_size_deserialize(buf, payload, 2);
+    }
+    if (status == PARSING_OK) {
+        status = address_arg_deserialize(buf, &payload->args.transfer.receiver);
     }
-    if (payload->args.ty_size != 1) {
-        return -TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
+    if (status == PARSING_OK) {
+        status = amount_arg_deserialize(buf, &payload->args.transfer.amount);
     }
 
-    uint32_t ty_arg_variant = TYPE_TAG_UNDEFINED;
-    // read type tag variant
-    if (!bcs_read_u32_from_uleb128(buf, &ty_arg_variant)) {
-        return TYPE_TAG_READ_ERROR;
+    return status;
+}
+
+parser_status_e coin_transfer_function_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
-    if (ty_arg_variant != TYPE_TAG_STRUCT) {
-        return TYPE_TAG_UNEXPECTED_ERROR;
+    entry_function_payload_t *payload = &tx->payload.entry_function;
+    if (payload->known_type != FUNC_COIN_TRANSFER &&
+        payload->known_type != FUNC_APTOS_ACCOUNT_TRANSFER_COINS) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
 
     agrs_coin_trasfer_t *coin_transfer = &payload->args.coin_transfer;
-    // read coin struct address field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &coin_transfer->ty_coin.address, ADDRESS_LEN)) {
-        return STRUCT_ADDRESS_READ_ERROR;
+    parser_status_e status = ty_args_size_deserialize(buf, payload, 1);
+    if (status == PARSING_OK) {
+        status = coin_type_deserialize(buf, &tx->arena, &coin_transfer->ty_coin);
+    }
+    if (status == PARSING_OK) {
+        status = args_size_deserialize(buf, payload, 2);
     }
-    // read coin struct module name len
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &coin_transfer->ty_coin.module_name.len)) {
-        return STRUCT_MODULE_LEN_READ_ERROR;
+    if (status == PARSING_OK) {
+        status = address_arg_deserialize(buf, &coin_transfer->receiver);
     }
-    // read coin struct module name field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &coin_transfer->ty_coin.module_name.bytes,
-                                     coin_transfer->ty_coin.module_name.len)) {
-        return STRUCT_MODULE_BYTES_READ_ERROR;
+    if (status == PARSING_OK) {
+        status = amount_arg_deserialize(buf, &coin_transfer->amount);
     }
-    // read coin struct name len
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &coin_transfer->ty_coin.name.len)) {
-        return STRUCT_NAME_LEN_READ_ERROR;
+
+    return status;
+}
+
+parser_status_e coin_register_function_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
-    // read coin struct name field
-    if (!bcs_read_ptr_to_fixed_bytes(buf,
-                                     &coin_transfer->ty_coin.name.bytes,
-                                     coin_transfer->ty_coin.name.len)) {
-        return STRUCT_NAME_BYTES_READ_ERROR;
+    entry_function_payload_t *payload = &tx->payload.entry_function;
+    if (payload->known_type != FUNC_COIN_REGISTER) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
-    // read coin struct args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &coin_transfer->ty_coin.type_args_size)) {
-        return STRUCT_TYPE_ARGS_SIZE_READ_ERROR;
+
+    parser_status_e status = ty_args_size_deserialize(buf, payload, 1);
+    if (status == PARSING_OK) {
+        status = coin_type_deserialize(buf, &tx->arena, &payload->args.coin_register.ty_coin);
     }
-    if (coin_transfer->ty_coin.type_args_size != 0) {
-        return STRUCT_TYPE_ARGS_SIZE_UNEXPECTED_ERROR;
+    if (status == PARSING_OK) {
+        status = args_size_deserialize(buf, payload, 0);
     }
 
-    // read args size
-    if (!bcs_read_u32_from_uleb128(buf, (uint32_t *) &payload->args.args_size)) {
-        return ARGS_SIZE_READ_ERROR;
+    return status;
+}
+
+parser_status_e stake_function_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
-    if (payload->args.args_size != 2) {
-        return ARGS_SIZE_UNEXPECTED_ERROR;
+    entry_function_payload_t *payload = &tx->payload.entry_function;
+    if (payload->known_type != FUNC_STAKE_ADD_STAKE && payload->known_type != FUNC_STAKE_UNLOCK &&
+        payload->known_type != FUNC_STAKE_WITHDRAW) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
-    uint32_t receiver_len;
-    // read receiver address len
-    if (!bcs_read_u32_from_uleb128(buf, &receiver_len)) {
-        return RECEIVER_ADDR_LEN_READ_ERROR;
+
+    parser_status_e status = ty_args_size_deserialize(buf, payload, 0);
+    if (status == PARSING_OK) {
+        status = args_size_deserialize(buf, payload, 1);
     }
-    if (receiver_len != ADDRESS_LEN) {
-        return WRONG_ADDRESS_LEN_ERROR;
+    if (status == PARSING_OK) {
+        status = amount_arg_deserialize(buf, &payload->args.stake.amount);
     }
-    // read receiver address field
-    if (!bcs_read_fixed_bytes(buf, (uint8_t *) &payload->args.transfer.receiver, ADDRESS_LEN)) {
-        return RECEIVER_ADDR_READ_ERROR;
+
+    return status;
+}
+
+parser_status_e delegation_pool_function_deserialize(buffer_t *buf, transaction_t *tx) {
+    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
-    uint32_t amount_len;
-    // read amount len
-    if (!bcs_read_u32_from_uleb128(buf, &amount_len)) {
-        return AMOUNT_LEN_READ_ERROR;
+    entry_function_payload_t *payload = &tx->payload.entry_function;
+    if (payload->known_type != FUNC_DELEGATION_POOL_ADD_STAKE &&
+        payload->known_type != FUNC_DELEGATION_POOL_UNLOCK &&
+        payload->known_type != FUNC_DELEGATION_POOL_REACTIVATE_STAKE &&
+        payload->known_type != FUNC_DELEGATION_POOL_WITHDRAW) {
+        return PAYLOAD_UNDEFINED_ERROR;
     }
-    if (amount_len != sizeof(uint64_t)) {
-        return WRONG_AMOUNT_LEN_ERROR;
+
+    parser_status_e status = ty_args_size_deserialize(buf, payload, 0);
+    if (status == PARSING_OK) {
+        status = args_size_deserialize(buf, payload, 2);
     }
-    // read amount field
-    if (!bcs_read_u64(buf, &payload->args.transfer.amount)) {
-        return AMOUNT_READ_ERROR;
+    if (status == PARSING_OK) {
+        status = address_arg_deserialize(buf, &payload->args.delegation_pool.pool_address);
+    }
+    if (status == PARSING_OK) {
+        status = amount_arg_deserialize(buf, &payload->args.delegation_pool.amount);
     }
 
-    return PARSING_OK;
+    return status;
 }
 
 entry_function_known_type_t determine_function_type(transaction_t *tx) {
@@ -320,16 +669,23 @@ entry_function_known_type_t determine_function_type(transaction_t *tx) {
         return FUNC_UNKNOWN;
     }
 
-    if (tx->payload.entry_function.module_id.address[ADDRESS_LEN - 1] == 0x01 &&
-        memcmp(tx->payload.entry_function.module_id.name.bytes, "aptos_account", 13) == 0 &&
-        memcmp(tx->payload.entry_function.function_name.bytes, "transfer", 8) == 0) {
-        return FUNC_APTOS_ACCOUNT_TRANSFER;
+    const entry_function_payload_t *payload = &tx->payload.entry_function;
+    if (!transaction_utils_is_framework_address(payload->module_id.address)) {
+        return FUNC_UNKNOWN;
     }
 
-    if (tx->payload.entry_function.module_id.address[ADDRESS_LEN - 1] == 0x01 &&
-        memcmp(tx->payload.entry_function.module_id.name.bytes, "coin", 4) == 0 &&
-        memcmp(tx->payload.entry_function.function_name.bytes, "transfer", 8) == 0) {
-        return FUNC_COIN_TRANSFER;
+    for (size_t i = 0; i < KNOWN_FUNCTIONS_LEN; i++) {
+        const known_function_t *function = &KNOWN_FUNCTIONS[i];
+        if (payload->module_id.name.len == function->module_name_len &&
+            payload->function_name.len == function->function_name_len &&
+            memcmp(payload->module_id.name.bytes,
+                   function->module_name,
+                   function->module_name_len) == 0 &&
+            memcmp(payload->function_name.bytes,
+                   function->function_name,
+                   function->function_name_len) == 0) {
+            return function->type;
+        }
     }
 
     return FUNC_UNKNOWN;
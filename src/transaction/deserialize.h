@@ -1,8 +1,21 @@
 #pragma once
 
+#include <stdbool.h>  // bool
+
 #include "types.h"
 #include "../common/buffer.h"
 
+/**
+ * Initialize resumable parser state and transaction structure.
+ *
+ * @param[out] state
+ *   Pointer to parser state.
+ * @param[out] tx
+ *   Pointer to transaction structure.
+ *
+ */
+void transaction_parser_init(tx_parser_state_t *state, transaction_t *tx);
+
 /**
  * Deserialize raw transaction in structure.
  *
@@ -16,14 +29,54 @@
  */
 parser_status_e transaction_deserialize(buffer_t *buf, transaction_t *tx);
 
-parser_status_e tx_raw_deserialize(buffer_t *buf, transaction_t *tx);
+/**
+ * Resume deserialization of raw transaction received in chunks.
+ *
+ * Fields are decoded as soon as their bytes are received. A field cut by the
+ * end of a chunk is decoded again from its first byte when the next chunk is
+ * received, so the buffer must keep all the bytes received so far.
+ *
+ * @param[in, out] state
+ *   Pointer to parser state initialized with transaction_parser_init().
+ * @param[in, out] buf
+ *   Pointer to buffer with all the bytes of serialized transaction received so far.
+ * @param[in, out] tx
+ *   Pointer to transaction structure.
+ * @param[in]      more
+ *   Whether more chunks of serialized transaction are expected or not.
+ *
+ * @return PARSING_INCOMPLETE if more chunks are expected, PARSING_OK if the
+ * whole transaction is decoded, error status otherwise.
+ *
+ */
+parser_status_e transaction_deserialize_chunk(tx_parser_state_t *state,
+                                              buffer_t *buf,
+                                              transaction_t *tx,
+                                              bool more);
+
+parser_status_e tx_step_deserialize(tx_parser_state_t *state,
+                                    buffer_t *buf,
+                                    transaction_t *tx,
+                                    bool more);
 
 parser_status_e tx_variant_deserialize(buffer_t *buf, transaction_t *tx);
 
+parser_status_e payload_variant_deserialize(buffer_t *buf, transaction_t *tx);
+
+parser_status_e tx_footer_deserialize(buffer_t *buf, transaction_t *tx);
+
 parser_status_e entry_function_payload_deserialize(buffer_t *buf, transaction_t *tx);
 
+parser_status_e known_function_args_deserialize(buffer_t *buf, transaction_t *tx);
+
 parser_status_e aptos_account_transfer_function_deserialize(buffer_t *buf, transaction_t *tx);
 
 parser_status_e coin_transfer_function_deserialize(buffer_t *buf, transaction_t *tx);
 
+parser_status_e coin_register_function_deserialize(buffer_t *buf, transaction_t *tx);
+
+parser_status_e stake_function_deserialize(buffer_t *buf, transaction_t *tx);
+
+parser_status_e delegation_pool_function_deserialize(buffer_t *buf, transaction_t *tx);
+
 entry_function_known_type_t determine_function_type(transaction_t *tx);
@@ -0,0 +1,638 @@
+/*****************************************************************************
+ *   Ledger App Boilerplate.
+ *   (c) 2020 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+#include <string.h>   // memset, strlen
+
+#include "fields.h"
+#include "../common/format.h"
+#include "../common/uint128.h"
+#include "../common/buffer.h"
+#include "../bcs/decoder.h"
+
+/**
+ * Append at most src_len characters of src to the string dst, truncated
+ * to dst_len like snprintf() does.
+ */
+static void str_append(char *dst, size_t dst_len, const char *src, size_t src_len) {
+    size_t len = strlen(dst);
+
+    for (size_t i = 0; i < src_len && src[i] != '\0' && len + 1 < dst_len; i++) {
+        dst[len++] = src[i];
+    }
+    dst[len] = '\0';
+}
+
+static void cstr_append(char *dst, size_t dst_len, const char *src) {
+    str_append(dst, dst_len, src, strlen(src));
+}
+
+/**
+ * Append bytes as uppercase hexadecimal to the string dst.
+ */
+static void hex_append(char *dst, size_t dst_len, const uint8_t *bytes, size_t bytes_len) {
+    char hex[3] = {0};
+
+    for (size_t i = 0; i < bytes_len; i++) {
+        format_hex(bytes + i, 1, hex, sizeof(hex));
+        str_append(dst, dst_len, hex, 2);
+    }
+}
+
+static void u64_append(char *dst, size_t dst_len, uint64_t value) {
+    char number[21] = {0};
+
+    format_u64(number, sizeof(number), value);
+    cstr_append(dst, dst_len, number);
+}
+
+static void address_append(char *dst, size_t dst_len, const uint8_t *address) {
+    cstr_append(dst, dst_len, "0x");
+    hex_append(dst, dst_len, address, ADDRESS_LEN);
+}
+
+static bool apt_amount_append(char *dst, size_t dst_len, uint64_t value) {
+    char amount[TX_FIELD_AMOUNT_LEN] = {0};
+
+    if (!format_fpu64(amount, sizeof(amount), value, 8)) {
+        return false;
+    }
+    cstr_append(dst, dst_len, "APT ");
+    cstr_append(dst, dst_len, amount);
+
+    return true;
+}
+
+static bool apt_amount_u128_append(char *dst, size_t dst_len, const uint128_t *value) {
+    // format_fpu128() wants room for the decimals on top of all digits
+    char amount[39 + 1 + 8 + 1] = {0};
+
+    if (!format_fpu128(amount, sizeof(amount), value, 8)) {
+        return false;
+    }
+    cstr_append(dst, dst_len, "APT ");
+    cstr_append(dst, dst_len, amount);
+
+    return true;
+}
+
+static void function_append(char *dst, size_t dst_len, const entry_function_payload_t *function) {
+    cstr_append(dst, dst_len, "0x");
+    hex_append(dst,
+               dst_len,
+               function->module_id.address + ADDRESS_LEN - TX_FIELD_MODULE_ADDRESS_LEN,
+               TX_FIELD_MODULE_ADDRESS_LEN);
+    cstr_append(dst, dst_len, "::");
+    str_append(dst,
+               dst_len,
+               (const char *) function->module_id.name.bytes,
+               function->module_id.name.len);
+    cstr_append(dst, dst_len, "::");
+    str_append(dst,
+               dst_len,
+               (const char *) function->function_name.bytes,
+               function->function_name.len);
+}
+
+static void struct_tag_append(char *dst, size_t dst_len, const type_tag_struct_t *ty_struct);
+
+/**
+ * Append a type tag in Move syntax, with struct addresses shortened.
+ */
+static void type_tag_append(char *dst, size_t dst_len, const type_tag_t *ty_val) {
+    switch (ty_val->type_tag) {
+        case TYPE_TAG_BOOL:
+            cstr_append(dst, dst_len, "bool");
+            break;
+        case TYPE_TAG_U8:
+            cstr_append(dst, dst_len, "u8");
+            break;
+        case TYPE_TAG_U16:
+            cstr_append(dst, dst_len, "u16");
+            break;
+        case TYPE_TAG_U32:
+            cstr_append(dst, dst_len, "u32");
+            break;
+        case TYPE_TAG_U64:
+            cstr_append(dst, dst_len, "u64");
+            break;
+        case TYPE_TAG_U128:
+            cstr_append(dst, dst_len, "u128");
+            break;
+        case TYPE_TAG_U256:
+            cstr_append(dst, dst_len, "u256");
+            break;
+        case TYPE_TAG_ADDRESS:
+            cstr_append(dst, dst_len, "address");
+            break;
+        case TYPE_TAG_SIGNER:
+            cstr_append(dst, dst_len, "signer");
+            break;
+        case TYPE_TAG_VECTOR:
+            cstr_append(dst, dst_len, "vector<");
+            type_tag_append(dst, dst_len, ty_val->value);
+            cstr_append(dst, dst_len, ">");
+            break;
+        case TYPE_TAG_STRUCT:
+            struct_tag_append(dst, dst_len, ty_val->value);
+            break;
+        default:
+            cstr_append(dst, dst_len, "?");
+            break;
+    }
+}
+
+/**
+ * Append a struct tag with its type args, nesting is bounded by the decoder
+ * (MAX_TYPE_TAG_NESTING).
+ */
+static void struct_tag_append(char *dst, size_t dst_len, const type_tag_struct_t *ty_struct) {
+    cstr_append(dst, dst_len, "0x");
+    hex_append(dst, dst_len, ty_struct->address, TX_FIELD_MODULE_ADDRESS_LEN);
+    cstr_append(dst, dst_len, "..");
+    hex_append(dst,
+               dst_len,
+               ty_struct->address + ADDRESS_LEN - TX_FIELD_MODULE_ADDRESS_LEN,
+               TX_FIELD_MODULE_ADDRESS_LEN);
+    cstr_append(dst, dst_len, "::");
+    str_append(dst,
+               dst_len,
+               (const char *) ty_struct->module_name.bytes,
+               ty_struct->module_name.len);
+    cstr_append(dst, dst_len, "::");
+    str_append(dst, dst_len, (const char *) ty_struct->name.bytes, ty_struct->name.len);
+    if (ty_struct->type_args_size == 0) {
+        return;
+    }
+    cstr_append(dst, dst_len, "<");
+    for (size_t i = 0; i < ty_struct->type_args_size; i++) {
+        if (i > 0) {
+            cstr_append(dst, dst_len, ", ");
+        }
+        type_tag_append(dst, dst_len, &ty_struct->type_args[i]);
+    }
+    cstr_append(dst, dst_len, ">");
+}
+
+static void secondary_signers_append(char *dst, size_t dst_len, const transaction_t *tx) {
+    const size_t shown = tx->secondary_signers_size < 2 ? tx->secondary_signers_size : 2;
+
+    if (tx->secondary_signers_size == 0) {
+        cstr_append(dst, dst_len, "None");
+    }
+    for (size_t i = 0; i < shown; i++) {
+        if (i > 0) {
+            cstr_append(dst, dst_len, " ");
+        }
+        address_append(dst, dst_len, tx->secondary_signers + i * ADDRESS_LEN);
+    }
+    if (tx->secondary_signers_size > shown) {
+        cstr_append(dst, dst_len, " (+");
+        u64_append(dst, dst_len, tx->secondary_signers_size - shown);
+        cstr_append(dst, dst_len, " more)");
+    }
+}
+
+static const type_tag_struct_t *coin_type(const entry_function_payload_t *function) {
+    switch (function->known_type) {
+        case FUNC_COIN_TRANSFER:
+        case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
+            return &function->args.coin_transfer.ty_coin;
+        case FUNC_COIN_REGISTER:
+            return &function->args.coin_register.ty_coin;
+        default:
+            return NULL;
+    }
+}
+
+size_t transaction_fields_list(const transaction_t *tx, tx_field_e *fields) {
+    size_t n = 0;
+
+    if (tx->tx_variant == TX_MESSAGE) {
+        fields[n++] = TX_FIELD_MESSAGE;
+        return n;
+    }
+
+    if ((tx->tx_variant != TX_RAW && tx->tx_variant != TX_RAW_WITH_DATA) ||
+        (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION && tx->payload_variant != PAYLOAD_SCRIPT)) {
+        fields[n++] = TX_FIELD_TX_TYPE;
+        fields[n++] = TX_FIELD_GAS_FEE;
+        fields[n++] = TX_FIELD_MESSAGE_HASH;
+        return n;
+    }
+
+    if (tx->tx_variant == TX_RAW_WITH_DATA) {
+        fields[n++] = TX_FIELD_WITH_DATA_TYPE;
+        if (tx->with_data_variant == TX_WITH_DATA_FEE_PAYER) {
+            fields[n++] = TX_FIELD_FEE_PAYER;
+        }
+        fields[n++] = TX_FIELD_SECONDARY_SIGNERS;
+    }
+
+    if (tx->payload_variant == PAYLOAD_SCRIPT) {
+        fields[n++] = TX_FIELD_TX_TYPE;
+        fields[n++] = TX_FIELD_SCRIPT_HASH;
+        fields[n++] = TX_FIELD_GAS_FEE;
+        fields[n++] = TX_FIELD_MESSAGE_HASH;
+        return n;
+    }
+
+    fields[n++] = TX_FIELD_FUNCTION;
+    switch (tx->payload.entry_function.known_type) {
+        case FUNC_APTOS_ACCOUNT_TRANSFER:
+            fields[n++] = TX_FIELD_RECEIVER;
+            fields[n++] = TX_FIELD_AMOUNT;
+            break;
+        case FUNC_COIN_TRANSFER:
+        case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
+            fields[n++] = TX_FIELD_COIN_TYPE;
+            fields[n++] = TX_FIELD_RECEIVER;
+            fields[n++] = TX_FIELD_AMOUNT;
+            break;
+        case FUNC_COIN_REGISTER:
+            fields[n++] = TX_FIELD_COIN_TYPE;
+            break;
+        case FUNC_STAKE_ADD_STAKE:
+        case FUNC_STAKE_UNLOCK:
+        case FUNC_STAKE_WITHDRAW:
+            fields[n++] = TX_FIELD_AMOUNT;
+            break;
+        case FUNC_DELEGATION_POOL_ADD_STAKE:
+        case FUNC_DELEGATION_POOL_UNLOCK:
+        case FUNC_DELEGATION_POOL_REACTIVATE_STAKE:
+        case FUNC_DELEGATION_POOL_WITHDRAW:
+            fields[n++] = TX_FIELD_POOL_ADDRESS;
+            fields[n++] = TX_FIELD_AMOUNT;
+            break;
+        default:
+            break;
+    }
+    fields[n++] = TX_FIELD_GAS_FEE;
+    fields[n++] = TX_FIELD_MESSAGE_HASH;
+
+    return n;
+}
+
+const char *transaction_field_title(tx_field_e field) {
+    switch (field) {
+        case TX_FIELD_TX_TYPE:
+        case TX_FIELD_WITH_DATA_TYPE:
+            return "Tx Type";
+        case TX_FIELD_FEE_PAYER:
+            return "Fee Payer";
+        case TX_FIELD_SECONDARY_SIGNERS:
+            return "Secondary Signers";
+        case TX_FIELD_MESSAGE:
+            return "Message";
+        case TX_FIELD_FUNCTION:
+            return "Function";
+        case TX_FIELD_COIN_TYPE:
+            return "Coin Type";
+        case TX_FIELD_RECEIVER:
+            return "Receiver";
+        case TX_FIELD_POOL_ADDRESS:
+            return "Pool Address";
+        case TX_FIELD_AMOUNT:
+            return "Amount";
+        case TX_FIELD_SCRIPT_HASH:
+            return "Script Hash";
+        case TX_FIELD_GAS_FEE:
+            return "Gas Fee";
+        case TX_FIELD_MESSAGE_HASH:
+            return "Message Hash";
+        default:
+            return "";
+    }
+}
+
+size_t transaction_field_len(tx_field_e field) {
+    switch (field) {
+        case TX_FIELD_FEE_PAYER:
+        case TX_FIELD_RECEIVER:
+        case TX_FIELD_POOL_ADDRESS:
+        case TX_FIELD_SCRIPT_HASH:
+            return TX_FIELD_ADDRESS_LEN;
+        case TX_FIELD_SECONDARY_SIGNERS:
+            return TX_FIELD_SIGNERS_LEN;
+        case TX_FIELD_FUNCTION:
+            return TX_FIELD_FUNCTION_LEN;
+        case TX_FIELD_AMOUNT:
+            return TX_FIELD_AMOUNT_LEN;
+        case TX_FIELD_GAS_FEE:
+            return TX_FIELD_GAS_FEE_LEN;
+        case TX_FIELD_MESSAGE_HASH:
+            return TX_FIELD_MESSAGE_HASH_LEN;
+        default:
+            return TX_FIELD_STRUCT_LEN;
+    }
+}
+
+bool transaction_field_format(const transaction_t *tx,
+                              tx_field_e field,
+                              const uint8_t *hash,
+                              char *out,
+                              size_t out_len) {
+    const entry_function_payload_t *function = &tx->payload.entry_function;
+    const type_tag_struct_t *ty_coin = NULL;
+
+    if (out_len == 0) {
+        return false;
+    }
+    if (out_len > transaction_field_len(field)) {
+        out_len = transaction_field_len(field);
+    }
+    memset(out, 0, out_len);
+
+    switch (field) {
+        case TX_FIELD_TX_TYPE:
+            if (tx->tx_variant != TX_RAW && tx->tx_variant != TX_RAW_WITH_DATA) {
+                cstr_append(out, out_len, "unknown data type");
+            } else if (tx->payload_variant == PAYLOAD_SCRIPT) {
+                cstr_append(out, out_len, "Script [");
+                u64_append(out, out_len, tx->payload.script.ty_size);
+                cstr_append(out, out_len, " type args, ");
+                u64_append(out, out_len, tx->payload.script.args_size);
+                cstr_append(out, out_len, " args]");
+            } else if (tx->tx_variant == TX_RAW) {
+                cstr_append(out, out_len, RAW_TRANSACTION_SALT " [payload = UNKNOWN]");
+            } else {
+                cstr_append(out, out_len, "unknown data type");
+            }
+            return true;
+        case TX_FIELD_WITH_DATA_TYPE:
+            cstr_append(out,
+                        out_len,
+                        tx->with_data_variant == TX_WITH_DATA_FEE_PAYER ? "Fee payer"
+                                                                        : "Multi-agent");
+            return true;
+        case TX_FIELD_FEE_PAYER:
+            if (tx->fee_payer == NULL) {
+                return false;
+            }
+            address_append(out, out_len, tx->fee_payer);
+            return true;
+        case TX_FIELD_SECONDARY_SIGNERS:
+            secondary_signers_append(out, out_len, tx);
+            return true;
+        case TX_FIELD_MESSAGE:
+            str_append(out, out_len, (const char *) tx->message.bytes, tx->message.len);
+            return true;
+        case TX_FIELD_FUNCTION:
+            function_append(out, out_len, function);
+            return true;
+        case TX_FIELD_COIN_TYPE:
+            ty_coin = coin_type(function);
+            if (ty_coin == NULL) {
+                return false;
+            }
+            struct_tag_append(out, out_len, ty_coin);
+            // a generic coin type cut on screen would hide which coin it is
+            return strlen(out) + 1 < out_len;
+        case TX_FIELD_RECEIVER:
+            switch (function->known_type) {
+                case FUNC_APTOS_ACCOUNT_TRANSFER:
+                    address_append(out, out_len, function->args.transfer.receiver);
+                    return true;
+                case FUNC_COIN_TRANSFER:
+                case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
+                    address_append(out, out_len, function->args.coin_transfer.receiver);
+                    return true;
+                default:
+                    return false;
+            }
+        case TX_FIELD_POOL_ADDRESS:
+            address_append(out, out_len, function->args.delegation_pool.pool_address);
+            return true;
+        case TX_FIELD_AMOUNT:
+            switch (function->known_type) {
+                case FUNC_APTOS_ACCOUNT_TRANSFER:
+                    return apt_amount_append(out, out_len, function->args.transfer.amount);
+                case FUNC_COIN_TRANSFER:
+                case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
+                    // coin may not be APT, the amount is displayed without unit
+                    return format_fpu64(out, out_len, function->args.coin_transfer.amount, 8);
+                case FUNC_STAKE_ADD_STAKE:
+                case FUNC_STAKE_UNLOCK:
+                case FUNC_STAKE_WITHDRAW:
+                    return apt_amount_append(out, out_len, function->args.stake.amount);
+                case FUNC_DELEGATION_POOL_ADD_STAKE:
+                case FUNC_DELEGATION_POOL_UNLOCK:
+                case FUNC_DELEGATION_POOL_REACTIVATE_STAKE:
+                case FUNC_DELEGATION_POOL_WITHDRAW:
+                    return apt_amount_append(out, out_len, function->args.delegation_pool.amount);
+                default:
+                    return false;
+            }
+        case TX_FIELD_SCRIPT_HASH:
+            if (hash == NULL) {
+                return false;
+            }
+            cstr_append(out, out_len, "0x");
+            hex_append(out, out_len, hash, 32);
+            return true;
+        case TX_FIELD_GAS_FEE: {
+            uint128_t fee;
+
+            u128_mul_u64(&fee, tx->gas_unit_price, tx->max_gas_amount);
+            return apt_amount_u128_append(out, out_len, &fee);
+        }
+        case TX_FIELD_MESSAGE_HASH:
+            if (hash == NULL) {
+                return false;
+            }
+            cstr_append(out, out_len, "0x");
+            hex_append(out, out_len, hash, TX_FIELD_MESSAGE_HASH_SHOWN_LEN);
+            cstr_append(out, out_len, "...");
+            hex_append(out,
+                       out_len,
+                       hash + 32 - TX_FIELD_MESSAGE_HASH_SHOWN_LEN,
+                       TX_FIELD_MESSAGE_HASH_SHOWN_LEN);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Whether bytes are printable ASCII, a string argument is displayed as
+ * hexadecimal otherwise.
+ */
+static bool printable_check(const uint8_t *bytes, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (bytes[i] < 0x20 || bytes[i] > 0x7E) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Append bytes as 0x-prefixed hexadecimal, only if they fit entirely.
+ */
+static bool hex_value_append(char *dst, size_t dst_len, const uint8_t *bytes, size_t bytes_len) {
+    const size_t len = strlen(dst);
+
+    if (len + 3 > dst_len || bytes_len > (dst_len - len - 3) / 2) {
+        return false;
+    }
+    cstr_append(dst, dst_len, "0x");
+    hex_append(dst, dst_len, bytes, bytes_len);
+
+    return true;
+}
+
+/**
+ * Read a BCS encoded vector<u8> or string.
+ */
+static bool abi_bytes_read(buffer_t *buf, uint8_t **bytes, size_t *len) {
+    uint32_t size = 0;
+
+    if (!bcs_read_u32_from_uleb128(buf, &size) || !bcs_read_ptr_to_fixed_bytes(buf, bytes, size)) {
+        return false;
+    }
+    *len = size;
+
+    return true;
+}
+
+bool transaction_abi_arg_format(const transaction_t *tx,
+                                const abi_descriptor_t *abi,
+                                size_t index,
+                                char *out,
+                                size_t out_len) {
+    const entry_function_payload_t *function = &tx->payload.entry_function;
+
+    if (out_len == 0) {
+        return false;
+    }
+    if (out_len > TX_FIELD_ARG_LEN) {
+        out_len = TX_FIELD_ARG_LEN;
+    }
+    memset(out, 0, out_len);
+
+    if (tx->payload_variant != PAYLOAD_ENTRY_FUNCTION || function->known_type != FUNC_UNKNOWN ||
+        function->args.raw.args == NULL || index >= abi->args_size ||
+        index >= function->args.args_size) {
+        return false;
+    }
+
+    const abi_arg_t *arg = &abi->args[index];
+    buffer_t buf = {.ptr = function->args.raw.args[index].bytes,
+                    .size = function->args.raw.args[index].len,
+                    .offset = 0};
+    bool ok = false;
+
+    switch (arg->type) {
+        case ABI_TYPE_BOOL: {
+            bool value = false;
+
+            ok = bcs_read_bool(&buf, &value);
+            if (ok) {
+                cstr_append(out, out_len, value ? "true" : "false");
+            }
+            break;
+        }
+        case ABI_TYPE_U8:
+        case ABI_TYPE_U16:
+        case ABI_TYPE_U32:
+        case ABI_TYPE_U64: {
+            uint8_t u8 = 0;
+            uint16_t u16 = 0;
+            uint32_t u32 = 0;
+            uint64_t value = 0;
+
+            if (arg->type == ABI_TYPE_U8) {
+                ok = bcs_read_u8(&buf, &u8);
+                value = u8;
+            } else if (arg->type == ABI_TYPE_U16) {
+                ok = bcs_read_u16(&buf, &u16);
+                value = u16;
+            } else if (arg->type == ABI_TYPE_U32) {
+                ok = bcs_read_u32(&buf, &u32);
+                value = u32;
+            } else {
+                ok = bcs_read_u64(&buf, &value);
+            }
+            ok = ok && (arg->decimals == 0 ? format_u64(out, out_len, value)
+                                           : format_fpu64(out, out_len, value, arg->decimals));
+            break;
+        }
+        case ABI_TYPE_U128: {
+            uint128_t value;
+
+            ok = bcs_read_u128(&buf, &value) &&
+                 (arg->decimals == 0 ? format_u128(out, out_len, &value)
+                                     : format_fpu128(out, out_len, &value, arg->decimals));
+            break;
+        }
+        case ABI_TYPE_U256: {
+            uint8_t *le = NULL;
+            uint8_t be[32] = {0};
+
+            ok = bcs_read_ptr_to_fixed_bytes(&buf, &le, sizeof(be));
+            if (ok) {
+                for (size_t i = 0; i < sizeof(be); i++) {
+                    be[i] = le[sizeof(be) - 1 - i];
+                }
+                ok = hex_value_append(out, out_len, be, sizeof(be));
+            }
+            break;
+        }
+        case ABI_TYPE_ADDRESS: {
+            uint8_t *address = NULL;
+
+            ok = bcs_read_ptr_to_fixed_bytes(&buf, &address, ADDRESS_LEN) &&
+                 hex_value_append(out, out_len, address, ADDRESS_LEN);
+            break;
+        }
+        case ABI_TYPE_STRING: {
+            uint8_t *bytes = NULL;
+            size_t len = 0;
+
+            ok = abi_bytes_read(&buf, &bytes, &len);
+            if (ok && printable_check(bytes, len)) {
+                ok = len < out_len;
+                if (ok) {
+                    str_append(out, out_len, (const char *) bytes, len);
+                }
+            } else if (ok) {
+                ok = hex_value_append(out, out_len, bytes, len);
+            }
+            break;
+        }
+        case ABI_TYPE_BYTES: {
+            uint8_t *bytes = NULL;
+            size_t len = 0;
+
+            ok = abi_bytes_read(&buf, &bytes, &len) && hex_value_append(out, out_len, bytes, len);
+            break;
+        }
+        default:
+            break;
+    }
+
+    // the whole argument must be decoded, like the transaction itself
+    if (!ok || buf.offset != buf.size) {
+        memset(out, 0, out_len);
+        return false;
+    }
+
+    return true;
+}
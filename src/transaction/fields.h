@@ -0,0 +1,144 @@
+#pragma once
+
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+
+#include "types.h"
+#include "../abi/descriptor.h"
+
+/**
+ * Size of the strings displayed for each kind of field, truncation at
+ * these sizes is part of what the user sees.
+ */
+#define TX_FIELD_AMOUNT_LEN       30
+#define TX_FIELD_GAS_FEE_LEN      (4 + 39 + 1 + 1)
+#define TX_FIELD_ADDRESS_LEN      (2 + 2 * ADDRESS_LEN + 1)
+#define TX_FIELD_FUNCTION_LEN     50
+#define TX_FIELD_STRUCT_LEN       250
+#define TX_FIELD_SIGNERS_LEN      (2 * (2 + 2 * ADDRESS_LEN) + 16)
+#define TX_FIELD_MESSAGE_HASH_LEN (2 + 4 * TX_FIELD_MESSAGE_HASH_SHOWN_LEN + 3 + 1)  // 0x, head, ..., tail
+#define TX_FIELD_ARG_LEN          TX_FIELD_STRUCT_LEN
+
+/**
+ * Number of trailing bytes of module and struct addresses displayed.
+ */
+#define TX_FIELD_MODULE_ADDRESS_LEN 1
+
+/**
+ * Number of leading and trailing bytes of the signing message hash displayed
+ * as its fingerprint.
+ */
+#define TX_FIELD_MESSAGE_HASH_SHOWN_LEN 4
+
+/**
+ * Maximum number of fields displayed for a transaction.
+ */
+#define TX_FIELDS_MAX 9
+
+/**
+ * Enumeration of the fields displayed for review of a transaction.
+ */
+typedef enum {
+    TX_FIELD_TX_TYPE = 0,         /// transaction type, script or unknown payload
+    TX_FIELD_WITH_DATA_TYPE,      /// multi-agent or fee payer
+    TX_FIELD_FEE_PAYER,           /// fee payer address
+    TX_FIELD_SECONDARY_SIGNERS,   /// secondary signers addresses
+    TX_FIELD_MESSAGE,             /// ASCII message
+    TX_FIELD_FUNCTION,            /// entry function
+    TX_FIELD_COIN_TYPE,           /// coin type struct tag
+    TX_FIELD_RECEIVER,            /// receiver address
+    TX_FIELD_POOL_ADDRESS,        /// delegation pool address
+    TX_FIELD_AMOUNT,              /// transferred or staked amount
+    TX_FIELD_SCRIPT_HASH,         /// SHA3-256 of script bytecode
+    TX_FIELD_GAS_FEE,             /// maximum gas fee
+    TX_FIELD_MESSAGE_HASH         /// fingerprint of SHA3-256 of signing message
+} tx_field_e;
+
+/**
+ * List the fields displayed for review of a transaction, in the order of
+ * the screens of the device (see ui/display.c), the blind signing warning of
+ * unknown entry functions aside.
+ *
+ * @param[in]  tx
+ *   Pointer to deserialized transaction.
+ * @param[out] fields
+ *   Pointer to array of at least TX_FIELDS_MAX fields.
+ *
+ * @return number of fields.
+ *
+ */
+size_t transaction_fields_list(const transaction_t *tx, tx_field_e *fields);
+
+/**
+ * Title of a field, as displayed on the device.
+ *
+ * @param[in] field
+ *   Field to get the title of.
+ *
+ * @return title string.
+ *
+ */
+const char *transaction_field_title(tx_field_e field);
+
+/**
+ * Size of the string displayed on the device for a field.
+ *
+ * @param[in] field
+ *   Field to get the size of.
+ *
+ * @return size of the string including its null terminator.
+ *
+ */
+size_t transaction_field_len(tx_field_e field);
+
+/**
+ * Format a field as displayed on the device. The string is truncated to
+ * transaction_field_len() like on the device.
+ *
+ * @param[in]  tx
+ *   Pointer to deserialized transaction.
+ * @param[in]  field
+ *   Field to format.
+ * @param[in]  hash
+ *   SHA3-256 of the script bytecode for TX_FIELD_SCRIPT_HASH, of the signing
+ *   message for TX_FIELD_MESSAGE_HASH, NULL otherwise.
+ * @param[out] out
+ *   Pointer to output string.
+ * @param[in]  out_len
+ *   Length of output string.
+ *
+ * @return true if success, false otherwise.
+ *
+ */
+bool transaction_field_format(const transaction_t *tx,
+                              tx_field_e field,
+                              const uint8_t *hash,
+                              char *out,
+                              size_t out_len);
+
+/**
+ * Format an argument of an unknown entry function with the type given by
+ * its descriptor. Unlike transaction_field_format(), a value is never
+ * truncated: it is not formatted at all if it does not fit.
+ *
+ * @param[in]  tx
+ *   Pointer to deserialized transaction.
+ * @param[in]  abi
+ *   Pointer to descriptor of the entry function.
+ * @param[in]  index
+ *   Index of the argument.
+ * @param[out] out
+ *   Pointer to output string.
+ * @param[in]  out_len
+ *   Length of output string, at most TX_FIELD_ARG_LEN is used.
+ *
+ * @return true if success, false if the argument is missing, does not
+ *   decode as its type or does not fit.
+ *
+ */
+bool transaction_abi_arg_format(const transaction_t *tx,
+                                const abi_descriptor_t *abi,
+                                size_t index,
+                                char *out,
+                                size_t out_len);
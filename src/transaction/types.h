@@ -4,11 +4,17 @@
 #include <stdint.h>  // uint*_t
 
 #include "../bcs/types.h"
+#include "../constants.h"
 
-#define MAX_TX_LEN 510
+/**
+ * Maximum length of the signing message parsed, the raw transaction
+ * buffered by the application.
+ */
+#define MAX_TX_LEN MAX_TRANSACTION_LEN
 
 typedef enum {
     PARSING_OK = 1,
+    PARSING_INCOMPLETE = 2,
     HASHED_PREFIX_READ_ERROR = -1,
     SENDER_READ_ERROR = -2,
     SEQUENCE_READ_ERROR = -3,
@@ -44,7 +50,49 @@ typedef enum {
     STRUCT_TYPE_ARGS_SIZE_UNEXPECTED_ERROR = -33,
     TX_VARIANT_READ_ERROR = -34,
     TX_VARIANT_UNDEFINED_ERROR = -35,
+    SCRIPT_CODE_READ_ERROR = -36,
+    ARG_READ_ERROR = -37,
+    TYPE_TAG_ARENA_FULL_ERROR = -38,
+    ARGS_ARENA_FULL_ERROR = -39,
+    WITH_DATA_VARIANT_READ_ERROR = -40,
+    WITH_DATA_VARIANT_UNDEFINED_ERROR = -41,
+    SECONDARY_SIGNERS_READ_ERROR = -42,
+    FEE_PAYER_READ_ERROR = -43,
     WRONG_LENGTH_ERROR = -2000
 } parser_status_e;
 
 typedef aptos_transaction_t transaction_t;
+
+/**
+ * Enumeration with the steps of the resumable transaction parser.
+ * Each step decodes a group of fields which is re-read from its beginning
+ * if it was cut by the end of an APDU chunk.
+ */
+typedef enum {
+    TX_STEP_VARIANT = 0,        /// hashed prefix or message
+    TX_STEP_MESSAGE,            /// ASCII message bytes
+    TX_STEP_RAW_WITH_DATA,      /// RawTransactionWithData variant
+    TX_STEP_SENDER,             /// sender address
+    TX_STEP_SEQUENCE,           /// sequence number
+    TX_STEP_PAYLOAD_VARIANT,    /// payload variant
+    TX_STEP_ENTRY_FUNCTION,     /// entry function module id and name
+    TX_STEP_KNOWN_FUNCTION,     /// type args and args of a known entry function
+    TX_STEP_SCRIPT_CODE,        /// script bytecode
+    TX_STEP_TYPE_ARGS_SIZE,     /// number of type args
+    TX_STEP_TYPE_ARG,           /// one type arg
+    TX_STEP_ARGS_SIZE,          /// number of args
+    TX_STEP_ARG,                /// one arg
+    TX_STEP_FOOTER,             /// gas, expiration and chain id
+    TX_STEP_SECONDARY_SIGNERS,  /// secondary signer addresses of RawTransactionWithData
+    TX_STEP_FEE_PAYER,          /// fee payer address of RawTransactionWithData
+    TX_STEP_DONE                /// whole transaction decoded
+} tx_parser_step_e;
+
+/**
+ * Structure with the state of the resumable transaction parser.
+ */
+typedef struct {
+    tx_parser_step_e step;  /// next step to decode
+    size_t offset;          /// offset of the first byte of the next step
+    size_t remaining;       /// items left in the vector being decoded
+} tx_parser_state_t;
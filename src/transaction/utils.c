@@ -17,16 +17,22 @@
 
 #include <stdint.h>   // uint*_t
 #include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
 #include <string.h>   // memmove
 
 #include "types.h"
+#include "../common/ascii.h"
 
 bool transaction_utils_check_encoding(const uint8_t *msg, uint64_t msg_len) {
-    for (uint64_t i = 0; i < msg_len; i++) {
-        if (msg[i] > 0x7F) {
+    return ascii_prefix_len(msg, (size_t) msg_len) == msg_len;
+}
+
+bool transaction_utils_is_framework_address(const uint8_t *address) {
+    for (size_t i = 0; i < ADDRESS_LEN - 1; i++) {
+        if (address[i] != 0x00) {
             return false;
         }
     }
 
-    return true;
+    return address[ADDRESS_LEN - 1] == 0x01;
 }
@@ -17,3 +17,14 @@
  *
  */
 bool transaction_utils_check_encoding(const uint8_t *msg, uint64_t msg_len);
+
+/**
+ * Check if address is the Aptos framework address 0x1.
+ *
+ * @param[in] address
+ *   Pointer to ADDRESS_LEN bytes of address.
+ *
+ * @return true if 0x1, false otherwise.
+ *
+ */
+bool transaction_utils_is_framework_address(const uint8_t *address);
@@ -1,7 +1,8 @@
 #pragma once
 
-#include <stddef.h>  // size_t
-#include <stdint.h>  // uint*_t
+#include <stddef.h>   // size_t
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
 
 #include "constants.h"
 #include "transaction/types.h"
@@ -20,10 +21,19 @@ typedef enum {
  * Enumeration with expected INS of APDU commands.
  */
 typedef enum {
-    GET_VERSION = 0x03,     /// version of the application
-    GET_APP_NAME = 0x04,    /// name of the application
-    GET_PUBLIC_KEY = 0x05,  /// public key of corresponding BIP32 path
-    SIGN_TX = 0x06          /// sign transaction with BIP32 path
+    GET_VERSION = 0x03,      /// version of the application
+    GET_APP_NAME = 0x04,     /// name of the application
+    GET_PUBLIC_KEY = 0x05,   /// public key of corresponding BIP32 path
+    SIGN_TX = 0x06,          /// sign transaction with BIP32 path
+    SIGN_TX_BATCH = 0x07,    /// sign batch of transactions with BIP32 path
+    GET_PUBLIC_KEYS = 0x08,  /// public keys of a range of BIP32 path indices
+    GET_SETTINGS = 0x09,     /// settings and transport limits
+#ifdef HAVE_ABI_DESCRIPTORS
+    PROVIDE_ABI = 0x0A,  /// signed descriptor of an entry function, for typed review
+#endif
+#ifdef HAVE_PROFILING
+    GET_PROFILE = 0xF0  /// stage ticks and stack usage of the last request (debug only)
+#endif
 } command_e;
 
 /**
@@ -34,7 +44,7 @@ typedef struct {
     command_e ins;  /// Instruction code
     uint8_t p1;     /// Instruction parameter 1
     uint8_t p2;     /// Instruction parameter 2
-    uint8_t lc;     /// Length of command data
+    uint16_t lc;    /// Length of command data
     uint8_t *data;  /// Command data
 } command_t;
 
@@ -51,8 +61,9 @@ typedef enum {
  * Enumeration with user request type.
  */
 typedef enum {
-    CONFIRM_ADDRESS,     /// confirm address derived from public key
-    CONFIRM_TRANSACTION  /// confirm transaction information
+    CONFIRM_ADDRESS,      /// confirm address derived from public key
+    CONFIRM_TRANSACTION,  /// confirm transaction information
+    CONFIRM_BATCH         /// confirm batch of transactions information
 } request_type_e;
 
 /**
@@ -60,21 +71,76 @@ typedef enum {
  */
 typedef struct {
     uint8_t raw_public_key[32];
-    uint8_t chain_code[32];  /// for public key derivation
+    uint8_t chain_code[32];        /// for public key derivation
+    uint8_t address[ADDRESS_LEN];  /// account address of public key
+    bool with_address;             /// whether to append address to response
 } pubkey_ctx_t;
 
 /**
  * Structure for transaction information context.
  */
 typedef struct {
-    uint8_t raw_tx[MAX_TRANSACTION_LEN];  /// raw transaction serialized
-    size_t raw_tx_len;                    /// length of raw transaction
-    transaction_t transaction;            /// structured transaction
-    uint8_t m_hash[64];                   /// message hash digest
-    uint8_t signature[MAX_DER_SIG_LEN];   /// transaction signature encoded in DER
-    uint8_t signature_len;                /// length of transaction signature
+    uint8_t raw_tx[MAX_TRANSACTION_LEN];     /// raw transaction serialized
+    size_t raw_tx_len;                       /// length of raw transaction
+    transaction_t transaction;               /// structured transaction
+    tx_parser_state_t parser;                /// state of the resumable transaction parser
+    uint16_t deferred_sw;                    /// error of a chunk processed after its acknowledgement
+    uint8_t message_hash[MESSAGE_HASH_LEN];  /// SHA3-256 of the signing message
+    uint8_t signature[MAX_DER_SIG_LEN];      /// transaction signature encoded in DER
+    uint8_t signature_len;                   /// length of transaction signature
 } transaction_ctx_t;
 
+/**
+ * Structure for batch signing context information.
+ */
+typedef struct {
+    uint8_t raw_private_key[32];  /// private key derived once for the whole batch
+    uint8_t sender[ADDRESS_LEN];  /// address of the account signing the batch
+    uint32_t tx_count;            /// number of transactions approved by the user
+    uint32_t tx_signed;           /// number of transactions already signed
+    uint64_t total_amount;        /// total amount approved by the user
+    uint64_t remaining_amount;    /// amount left for the transactions to sign
+    uint64_t max_gas_fee;         /// maximum gas fee approved for each transaction
+    uint8_t chain_id;             /// chain of the first transaction signed in the batch
+} batch_ctx_t;
+
+#ifdef HAVE_PROFILING
+/**
+ * Maximum number of profiling records kept, oldest ones are overwritten.
+ */
+#define PROFILE_RECORDS_LEN 24
+
+/**
+ * Enumeration with the profiled stages of signing.
+ */
+typedef enum {
+    PROFILE_STAGE_CHUNK_COPY = 0,  /// copy of APDU chunk in raw transaction
+    PROFILE_STAGE_PARSE = 1,       /// transaction_deserialize_chunk()
+    PROFILE_STAGE_HASH = 2,        /// SHA3-256 of the signing message
+    PROFILE_STAGE_DERIVE = 3,      /// derivation of private key
+    PROFILE_STAGE_SIGN = 4         /// cx_eddsa_sign()
+} profile_stage_e;
+
+/**
+ * Structure for one profiling record.
+ */
+typedef struct {
+    uint8_t stage;        /// profile_stage_e
+    uint8_t end;          /// 0 when the stage begins, 1 when it ends
+    uint16_t stack_used;  /// stack high-water mark (bytes) when recorded
+    uint32_t ticks;       /// ticker events (100 ms each) since the application started
+} profile_record_t;
+
+/**
+ * Structure for profiling ring buffer.
+ */
+typedef struct {
+    profile_record_t records[PROFILE_RECORDS_LEN];
+    uint8_t next;   /// index of next record to write
+    uint8_t count;  /// number of records written, up to PROFILE_RECORDS_LEN
+} profile_ctx_t;
+#endif
+
 /**
  * Structure for global context.
  */
@@ -84,7 +150,28 @@ typedef struct {
         pubkey_ctx_t pk_info;       /// public key context
         transaction_ctx_t tx_info;  /// transaction context
     };
+    batch_ctx_t batch_info;               /// batch signing context
     request_type_e req_type;              /// user request
     uint32_t bip32_path[MAX_BIP32_PATH];  /// BIP32 path
     uint8_t bip32_path_len;               /// length of BIP32 path
+#ifdef HAVE_PROFILING
+    profile_ctx_t profile;  /// records of the current request, reset with the context
+#endif
 } global_ctx_t;
+
+/**
+ * Version of the layout of internal_storage_t, a storage of another
+ * version is reinitialized with defaults (see settings_init()).
+ */
+#define SETTINGS_VERSION 1
+
+/**
+ * Structure for settings stored in NVM.
+ */
+typedef struct {
+    uint8_t blind_signing;   /// whether unknown entry functions can be signed
+    uint8_t initialized;     /// whether the storage has been initialized
+    uint8_t version;         /// layout version, SETTINGS_VERSION
+    uint8_t expert_mode;     /// full message hash instead of fingerprint
+    uint32_t account_index;  /// account of the last address confirmed on screen
+} internal_storage_t;
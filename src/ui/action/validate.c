@@ -23,11 +23,17 @@
 #include "../../io.h"
 #include "../../crypto.h"
 #include "../../globals.h"
+#include "../../settings.h"
 #include "../../helper/send_response.h"
+#include "../../handler/sign_tx_batch.h"
 
 void ui_action_validate_pubkey(bool choice) {
     if (choice) {
         helper_send_response_pubkey();
+        // m/44'/637'/account'/...
+        if (G_context.bip32_path_len > 2) {
+            settings_set_account_index(G_context.bip32_path[2]);
+        }
     } else {
         io_send_sw(SW_DENY);
     }
@@ -52,3 +58,20 @@ void ui_action_validate_transaction(bool choice) {
 
     ui_menu_main();
 }
+
+void ui_action_validate_batch(bool choice) {
+    if (G_context.batch_info.tx_count == 0) {
+        // batch wiped while under review, e.g. device locked
+        G_context.state = STATE_NONE;
+        io_send_sw(SW_BAD_STATE);
+    } else if (choice) {
+        sign_tx_batch_derive_key();
+        G_context.state = STATE_APPROVED;
+        io_send_sw(SW_OK);
+    } else {
+        sign_tx_batch_wipe();
+        io_send_sw(SW_DENY);
+    }
+
+    ui_menu_main();
+}
@@ -19,3 +19,12 @@ void ui_action_validate_pubkey(bool choice);
  *
  */
 void ui_action_validate_transaction(bool choice);
+
+/**
+ * Action for batch limits validation.
+ *
+ * @param[in] choice
+ *   User choice (either approved or rejectd).
+ *
+ */
+void ui_action_validate_batch(bool choice);
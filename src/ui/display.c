@@ -19,10 +19,11 @@
 #pragma GCC diagnostic ignored "-Wformat-extra-args"         // snprintf
 
 #include <stdbool.h>  // bool
-#include <string.h>   // memset
+#include <string.h>   // memset, strlen
 
 #include "os.h"
 #include "ux.h"
+#include "cx.h"
 #include "glyphs.h"
 
 #include "display.h"
@@ -30,36 +31,70 @@
 #include "../globals.h"
 #include "../io.h"
 #include "../sw.h"
-#include "../address.h"
 #include "action/validate.h"
 #include "../transaction/types.h"
+#include "../transaction/fields.h"
 #include "../common/bip32.h"
 #include "../common/format.h"
+#ifdef HAVE_ABI_DESCRIPTORS
+#include "../abi/cache.h"
+#include "../abi/descriptor.h"
+#endif
 
 static action_validate_cb g_validate_callback;
-static char g_amount[30];
-static char g_gas_fee[30];
-static char g_bip32_path[60];
-static char g_address[67];
-static char g_function[50];
-static char g_struct[250];
+// Text of the step on screen, formatted by the init of each step right
+// before it is displayed, see ui_render_tx_field()
+static char g_scratch[TX_FIELD_STRUCT_LEN];
+// Steps of the transaction flow being displayed, see ui_display_tx_flow()
+#ifdef HAVE_ABI_DESCRIPTORS
+static const ux_flow_step_t *g_tx_flow[16 + ABI_ARGS_MAX];
+// Descriptor of the entry function under review, it points into G_abi_cache
+// which PROVIDE_ABI does not change during a review
+static abi_descriptor_t g_abi;
+// Title of the argument step on screen, see ui_render_abi_arg()
+static char g_title[ABI_NAME_MAX_LEN + 1];
+#else
+static const ux_flow_step_t *g_tx_flow[16];
+#endif
+
+/**
+ * Format BIP32 path of the request in g_scratch.
+ */
+static void ui_render_bip32_path() {
+    memset(g_scratch, 0, sizeof(g_scratch));
+    bip32_path_format(G_context.bip32_path, G_context.bip32_path_len, g_scratch, sizeof(g_scratch));
+}
+
+/**
+ * Format address of the public key of the request in g_scratch.
+ */
+static void ui_render_pubkey_address() {
+    memset(g_scratch, 0, sizeof(g_scratch));
+    snprintf(g_scratch,
+             sizeof(g_scratch),
+             "0x%.*H",
+             sizeof(G_context.pk_info.address),
+             G_context.pk_info.address);
+}
 
 // Step with icon and text
 UX_STEP_NOCB(ux_display_confirm_addr_step, pn, {&C_icon_eye, "Confirm Address"});
 // Step with title/text for BIP32 path
-UX_STEP_NOCB(ux_display_path_step,
-             bnnn_paging,
-             {
-                 .title = "Path",
-                 .text = g_bip32_path,
-             });
+UX_STEP_NOCB_INIT(ux_display_path_step,
+                  bnnn_paging,
+                  ui_render_bip32_path(),
+                  {
+                      .title = "Path",
+                      .text = g_scratch,
+                  });
 // Step with title/text for address
-UX_STEP_NOCB(ux_display_address_step,
-             bnnn_paging,
-             {
-                 .title = "Address",
-                 .text = g_address,
-             });
+UX_STEP_NOCB_INIT(ux_display_address_step,
+                  bnnn_paging,
+                  ui_render_pubkey_address(),
+                  {
+                      .title = "Address",
+                      .text = g_scratch,
+                  });
 // Step with approve button
 UX_STEP_CB(ux_display_approve_step,
            pb,
@@ -96,21 +131,11 @@ int ui_display_address() {
         return io_send_sw(SW_BAD_STATE);
     }
 
-    memset(g_bip32_path, 0, sizeof(g_bip32_path));
-    if (!bip32_path_format(G_context.bip32_path,
-                           G_context.bip32_path_len,
-                           g_bip32_path,
-                           sizeof(g_bip32_path))) {
+    // any valid path fits in g_scratch, formatting cannot fail later
+    if (G_context.bip32_path_len == 0 || G_context.bip32_path_len > MAX_BIP32_PATH) {
         return io_send_sw(SW_DISPLAY_BIP32_PATH_FAIL);
     }
 
-    memset(g_address, 0, sizeof(g_address));
-    uint8_t address[ADDRESS_LEN] = {0};
-    if (!address_from_pubkey(G_context.pk_info.raw_public_key, address, sizeof(address))) {
-        return io_send_sw(SW_DISPLAY_ADDRESS_FAIL);
-    }
-    snprintf(g_address, sizeof(g_address), "0x%.*H", sizeof(address), address);
-
     g_validate_callback = &ui_action_validate_pubkey;
 
     ux_flow_init(0, ux_display_pubkey_flow, NULL);
@@ -118,6 +143,58 @@ int ui_display_address() {
     return 0;
 }
 
+/**
+ * Format a field of the transaction under review in g_scratch, truncated
+ * to its displayed size.
+ */
+static void ui_render_tx_field(tx_field_e field) {
+    const transaction_t *transaction = &G_context.tx_info.transaction;
+    uint8_t code_hash[32] = {0};
+    const uint8_t *hash = NULL;
+
+    memset(g_scratch, 0, sizeof(g_scratch));
+    switch (field) {
+        case TX_FIELD_SCRIPT_HASH: {
+            // bytecode can be kilobytes long, only its hash fits on screen
+            const script_payload_t *script = &transaction->payload.script;
+            cx_sha3_t sha3;
+
+            cx_sha3_init(&sha3, 256);
+            if (cx_hash((cx_hash_t *) &sha3,
+                        CX_LAST,
+                        script->code.bytes,
+                        script->code.len,
+                        code_hash,
+                        sizeof(code_hash)) != sizeof(code_hash)) {
+                // never show a digest which was not computed
+                snprintf(g_scratch, sizeof(g_scratch), "Hash error");
+                return;
+            }
+            hash = code_hash;
+            break;
+        }
+        case TX_FIELD_MESSAGE_HASH:
+            if (N_storage.expert_mode) {
+                snprintf(g_scratch,
+                         sizeof(g_scratch),
+                         "0x%.*H",
+                         sizeof(G_context.tx_info.message_hash),
+                         G_context.tx_info.message_hash);
+                return;
+            }
+            hash = G_context.tx_info.message_hash;
+            break;
+        default:
+            break;
+    }
+    size_t len = transaction_field_len(field);
+    if (len > sizeof(g_scratch)) {
+        len = sizeof(g_scratch);
+    }
+    transaction_field_format(transaction, field, hash, g_scratch, len);
+    PRINTF("%s: %s\n", transaction_field_title(field), g_scratch);
+}
+
 // Step with icon and text
 UX_STEP_NOCB(ux_display_review_step,
              pnn,
@@ -135,54 +212,117 @@ UX_STEP_NOCB(ux_display_review_msg_step,
                  "Message",
              });
 // Step with title/text for message
-UX_STEP_NOCB(ux_display_msg_step,
-             bnnn_paging,
-             {
-                 .title = "Message",
-                 .text = g_struct,
-             });
+UX_STEP_NOCB_INIT(ux_display_msg_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_MESSAGE),
+                  {
+                      .title = "Message",
+                      .text = g_scratch,
+                  });
 // Step with title/text for transaction type
-UX_STEP_NOCB(ux_display_tx_type_step,
-             bnnn_paging,
-             {
-                 .title = "Tx Type",
-                 .text = g_struct,
-             });
+UX_STEP_NOCB_INIT(ux_display_tx_type_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_TX_TYPE),
+                  {
+                      .title = "Tx Type",
+                      .text = g_scratch,
+                  });
 // Step with title/text for function
-UX_STEP_NOCB(ux_display_function_step,
-             bnnn_paging,
-             {
-                 .title = "Function",
-                 .text = g_function,
-             });
+UX_STEP_NOCB_INIT(ux_display_function_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_FUNCTION),
+                  {
+                      .title = "Function",
+                      .text = g_scratch,
+                  });
 // Step with title/text for coin type
-UX_STEP_NOCB(ux_display_coin_type_step,
-             bnnn_paging,
-             {
-                 .title = "Coin Type",
-                 .text = g_struct,
-             });
+UX_STEP_NOCB_INIT(ux_display_coin_type_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_COIN_TYPE),
+                  {
+                      .title = "Coin Type",
+                      .text = g_scratch,
+                  });
 // Step with title/text for receiver
-UX_STEP_NOCB(ux_display_receiver_step,
-             bnnn_paging,
-             {
-                 .title = "Receiver",
-                 .text = g_address,
-             });
+UX_STEP_NOCB_INIT(ux_display_receiver_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_RECEIVER),
+                  {
+                      .title = "Receiver",
+                      .text = g_scratch,
+                  });
 // Step with title/text for amount
-UX_STEP_NOCB(ux_display_amount_step,
+UX_STEP_NOCB_INIT(ux_display_amount_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_AMOUNT),
+                  {
+                      .title = "Amount",
+                      .text = g_scratch,
+                  });
+// Step with title/text for multi-agent transaction type
+UX_STEP_NOCB(ux_display_multi_agent_step,
              bnnn_paging,
              {
-                 .title = "Amount",
-                 .text = g_amount,
+                 .title = "Tx Type",
+                 .text = "Multi-agent",
              });
-// Step with title/text for gas fee
-UX_STEP_NOCB(ux_display_gas_fee_step,
+// Step with title/text for fee payer transaction type
+UX_STEP_NOCB(ux_display_fee_payer_type_step,
              bnnn_paging,
              {
-                 .title = "Gas Fee",
-                 .text = g_gas_fee,
+                 .title = "Tx Type",
+                 .text = "Fee payer",
              });
+// Step with title/text for secondary signers
+UX_STEP_NOCB_INIT(ux_display_secondary_signers_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_SECONDARY_SIGNERS),
+                  {
+                      .title = "Secondary Signers",
+                      .text = g_scratch,
+                  });
+// Step with title/text for fee payer
+UX_STEP_NOCB_INIT(ux_display_fee_payer_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_FEE_PAYER),
+                  {
+                      .title = "Fee Payer",
+                      .text = g_scratch,
+                  });
+// Step with title/text for script bytecode hash
+UX_STEP_NOCB_INIT(ux_display_script_hash_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_SCRIPT_HASH),
+                  {
+                      .title = "Script Hash",
+                      .text = g_scratch,
+                  });
+// Step with title/text for delegation pool address
+UX_STEP_NOCB_INIT(ux_display_pool_address_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_POOL_ADDRESS),
+                  {
+                      .title = "Pool Address",
+                      .text = g_scratch,
+                  });
+// Step with title/text for gas fee
+UX_STEP_NOCB_INIT(ux_display_gas_fee_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_GAS_FEE),
+                  {
+                      .title = "Gas Fee",
+                      .text = g_scratch,
+                  });
+// Step with warning icon for review of unknown entry functions
+UX_STEP_NOCB(ux_display_blind_signing_step, pnn, {&C_icon_warning, "Blind", "Signing"});
+// Step with title/text for fingerprint of signing message hash
+UX_STEP_NOCB_INIT(ux_display_message_hash_step,
+                  bnnn_paging,
+                  ui_render_tx_field(TX_FIELD_MESSAGE_HASH),
+                  {
+                      .title = "Message Hash",
+                      .text = g_scratch,
+                  });
 
 // FLOW to display default transaction information:
 // #1 screen : eye icon + "Review Transaction"
@@ -208,14 +348,16 @@ UX_FLOW(ux_display_message_flow,
         &ux_display_approve_step,
         &ux_display_reject_step);
 
-// FLOW to display entry_function transaction information:
+// FLOW to display unknown entry function transaction with blind signing enabled:
 // #1 screen : eye icon + "Review Transaction"
-// #2 screen : display function name
-// #3 screen : display gas fee
-// #4 screen : approve button
-// #5 screen : reject button
-UX_FLOW(ux_display_tx_entry_function_flow,
+// #2 screen : warning icon + "Blind Signing"
+// #3 screen : display function name
+// #4 screen : display gas fee
+// #5 screen : approve button
+// #6 screen : reject button
+UX_FLOW(ux_display_tx_blind_flow,
         &ux_display_review_step,
+        &ux_display_blind_signing_step,
         &ux_display_function_step,
         &ux_display_gas_fee_step,
         &ux_display_approve_step,
@@ -257,6 +399,180 @@ UX_FLOW(ux_display_tx_coin_transfer_flow,
         &ux_display_approve_step,
         &ux_display_reject_step);
 
+// FLOW to display script transaction information:
+// #1 screen : eye icon + "Review Transaction"
+// #2 screen : display tx type
+// #3 screen : display SHA3-256 of script bytecode
+// #4 screen : display gas fee
+// #5 screen : approve button
+// #6 screen : reject button
+UX_FLOW(ux_display_tx_script_flow,
+        &ux_display_review_step,
+        &ux_display_tx_type_step,
+        &ux_display_script_hash_step,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+// FLOW to display coin_register transaction information:
+// #1 screen : eye icon + "Review Transaction"
+// #2 screen : display function name
+// #3 screen : display coin type
+// #4 screen : display gas fee
+// #5 screen : approve button
+// #6 screen : reject button
+UX_FLOW(ux_display_tx_coin_register_flow,
+        &ux_display_review_step,
+        &ux_display_function_step,
+        &ux_display_coin_type_step,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+// FLOW to display stake transaction information:
+// #1 screen : eye icon + "Review Transaction"
+// #2 screen : display function name
+// #3 screen : display amount
+// #4 screen : display gas fee
+// #5 screen : approve button
+// #6 screen : reject button
+UX_FLOW(ux_display_tx_stake_flow,
+        &ux_display_review_step,
+        &ux_display_function_step,
+        &ux_display_amount_step,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+// FLOW to display delegation_pool transaction information:
+// #1 screen : eye icon + "Review Transaction"
+// #2 screen : display function name
+// #3 screen : display delegation pool address
+// #4 screen : display amount
+// #5 screen : display gas fee
+// #6 screen : approve button
+// #7 screen : reject button
+UX_FLOW(ux_display_tx_delegation_pool_flow,
+        &ux_display_review_step,
+        &ux_display_function_step,
+        &ux_display_pool_address_step,
+        &ux_display_amount_step,
+        &ux_display_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+#ifdef HAVE_ABI_DESCRIPTORS
+/**
+ * Format name and value of an argument of the entry function under review
+ * in g_title and g_scratch.
+ */
+static void ui_render_abi_arg(size_t index) {
+    const abi_arg_t *arg = &g_abi.args[index];
+
+    memset(g_title, 0, sizeof(g_title));
+    memcpy(g_title, arg->name.bytes, arg->name.len);
+    transaction_abi_arg_format(&G_context.tx_info.transaction,
+                               &g_abi,
+                               index,
+                               g_scratch,
+                               sizeof(g_scratch));
+    PRINTF("%s: %s\n", g_title, g_scratch);
+}
+
+// Step with title/text for an argument described by g_abi
+#define UX_STEP_ABI_ARG(index)                                  \
+    UX_STEP_NOCB_INIT(ux_display_abi_arg_##index##_step,        \
+                      bnnn_paging,                              \
+                      ui_render_abi_arg(index),                 \
+                      {                                         \
+                          .title = g_title,                     \
+                          .text = g_scratch,                    \
+                      })
+UX_STEP_ABI_ARG(0);
+UX_STEP_ABI_ARG(1);
+UX_STEP_ABI_ARG(2);
+UX_STEP_ABI_ARG(3);
+UX_STEP_ABI_ARG(4);
+UX_STEP_ABI_ARG(5);
+UX_STEP_ABI_ARG(6);
+UX_STEP_ABI_ARG(7);
+
+static const ux_flow_step_t *const ux_display_abi_arg_steps[ABI_ARGS_MAX] = {
+    &ux_display_abi_arg_0_step,
+    &ux_display_abi_arg_1_step,
+    &ux_display_abi_arg_2_step,
+    &ux_display_abi_arg_3_step,
+    &ux_display_abi_arg_4_step,
+    &ux_display_abi_arg_5_step,
+    &ux_display_abi_arg_6_step,
+    &ux_display_abi_arg_7_step,
+};
+#endif
+
+/**
+ * Maximum number of steps inserted by ui_display_tx_flow(): fee payer type,
+ * fee payer, secondary signers and message hash.
+ */
+#define TX_FLOW_INSERTED_STEPS 4
+
+/**
+ * Number of steps of a flow, FLOW_END_STEP included.
+ */
+#define TX_FLOW_LEN(flow) (sizeof(flow) / sizeof((flow)[0]))
+
+/**
+ * Check at build time that a flow and the steps inserted in it fit in
+ * g_tx_flow, so that a review is never cut short.
+ */
+#define TX_FLOW_CHECK(flow)                                                              \
+    _Static_assert(TX_FLOW_LEN(flow) + TX_FLOW_INSERTED_STEPS <= TX_FLOW_LEN(g_tx_flow), \
+                   #flow " does not fit in g_tx_flow")
+
+TX_FLOW_CHECK(ux_display_tx_default_flow);
+TX_FLOW_CHECK(ux_display_tx_blind_flow);
+TX_FLOW_CHECK(ux_display_tx_aptos_account_transfer_flow);
+TX_FLOW_CHECK(ux_display_tx_coin_transfer_flow);
+TX_FLOW_CHECK(ux_display_tx_script_flow);
+TX_FLOW_CHECK(ux_display_tx_coin_register_flow);
+TX_FLOW_CHECK(ux_display_tx_stake_flow);
+TX_FLOW_CHECK(ux_display_tx_delegation_pool_flow);
+
+/**
+ * Start transaction flow, with the multi-agent steps inserted after the
+ * review step for RawTransactionWithData with a known payload and the
+ * message hash inserted before the approve step.
+ *
+ * @see TX_FLOW_CHECK for the size of the flow.
+ */
+static int ui_display_tx_flow(const ux_flow_step_t *const *flow) {
+    const transaction_t *transaction = &G_context.tx_info.transaction;
+
+    size_t n = 0;
+    g_tx_flow[n++] = flow[0];
+    if (transaction->tx_variant == TX_RAW_WITH_DATA &&
+        (transaction->payload_variant == PAYLOAD_ENTRY_FUNCTION ||
+         transaction->payload_variant == PAYLOAD_SCRIPT)) {
+        if (transaction->with_data_variant == TX_WITH_DATA_FEE_PAYER) {
+            g_tx_flow[n++] = &ux_display_fee_payer_type_step;
+            g_tx_flow[n++] = &ux_display_fee_payer_step;
+        } else {
+            g_tx_flow[n++] = &ux_display_multi_agent_step;
+        }
+        g_tx_flow[n++] = &ux_display_secondary_signers_step;
+    }
+    for (size_t i = 1; flow[i] != FLOW_END_STEP; i++) {
+        if (flow[i] == &ux_display_approve_step) {
+            g_tx_flow[n++] = &ux_display_message_hash_step;
+        }
+        g_tx_flow[n++] = flow[i];
+    }
+    g_tx_flow[n] = FLOW_END_STEP;
+
+    ux_flow_init(0, g_tx_flow, NULL);
+
+    return 0;
+}
+
 int ui_display_transaction() {
     if (G_context.req_type != CONFIRM_TRANSACTION || G_context.state != STATE_PARSED) {
         G_context.state = STATE_NONE;
@@ -265,139 +581,272 @@ int ui_display_transaction() {
 
     g_validate_callback = &ui_action_validate_transaction;
 
-    transaction_t *transaction = &G_context.tx_info.transaction;
-
-    uint64_t gas_fee_value = transaction->gas_unit_price * transaction->max_gas_amount;
-    memset(g_gas_fee, 0, sizeof(g_gas_fee));
-    char gas_fee[30] = {0};
-    if (!format_fpu64(gas_fee, sizeof(gas_fee), gas_fee_value, 8)) {
-        return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);  // TODO: SW_DISPLAY_GAS_FEE_FAIL
-    }
-    snprintf(g_gas_fee, sizeof(g_gas_fee), "APT %.*s", sizeof(gas_fee), gas_fee);
-    PRINTF("Gas Fee: %s\n", g_gas_fee);
+    const transaction_t *transaction = &G_context.tx_info.transaction;
 
     if (transaction->tx_variant == TX_RAW) {
         switch (transaction->payload_variant) {
             case PAYLOAD_ENTRY_FUNCTION:
                 return ui_display_entry_function();
             case PAYLOAD_SCRIPT:
-                memset(g_struct, 0, sizeof(g_struct));
-                snprintf(g_struct, sizeof(g_struct), "%s [payload = SCRIPT]", RAW_TRANSACTION_SALT);
-                break;
+                return ui_display_script();
             default:
-                memset(g_struct, 0, sizeof(g_struct));
-                snprintf(g_struct,
-                         sizeof(g_struct),
-                         "%s [payload = UNKNOWN]",
-                         RAW_TRANSACTION_SALT);
                 break;
         }
     } else if (transaction->tx_variant == TX_MESSAGE) {
         return ui_display_message();
-    } else if (transaction->tx_variant == TX_RAW_WITH_DATA) {
-        memset(g_struct, 0, sizeof(g_struct));
-        snprintf(g_struct, sizeof(g_struct), RAW_TRANSACTION_WITH_DATA_SALT);
-    } else {
-        memset(g_struct, 0, sizeof(g_struct));
-        snprintf(g_struct, sizeof(g_struct), "unknown data type");
+    } else if (transaction->tx_variant == TX_RAW_WITH_DATA &&
+               transaction->payload_variant == PAYLOAD_ENTRY_FUNCTION) {
+        return ui_display_entry_function();
+    } else if (transaction->tx_variant == TX_RAW_WITH_DATA &&
+               transaction->payload_variant == PAYLOAD_SCRIPT) {
+        return ui_display_script();
     }
 
-    ux_flow_init(0, ux_display_tx_default_flow, NULL);
-
-    return 0;
+    return ui_display_tx_flow(ux_display_tx_default_flow);
 }
 
 int ui_display_message() {
-    memset(g_struct, 0, sizeof(g_struct));
-    snprintf(g_struct,
-             sizeof(g_struct),
-             "%.*s",
-             G_context.tx_info.raw_tx_len,
-             G_context.tx_info.raw_tx);
-    PRINTF("Message: %s\n", g_struct);
-
     ux_flow_init(0, ux_display_message_flow, NULL);
 
     return 0;
 }
 
+int ui_display_script() {
+    return ui_display_tx_flow(ux_display_tx_script_flow);
+}
+
+#ifdef HAVE_ABI_DESCRIPTORS
+/**
+ * Find the descriptor of the unknown entry function under review in g_abi,
+ * only if it describes every argument and each of them can be displayed.
+ * Generic functions are not reviewed with a descriptor, it does not
+ * describe their type arguments.
+ */
+static bool ui_abi_lookup() {
+    const transaction_t *transaction = &G_context.tx_info.transaction;
+    const entry_function_payload_t *function = &transaction->payload.entry_function;
+
+    if (function->known_type != FUNC_UNKNOWN || function->args.ty_size != 0 ||
+        !abi_cache_find(&G_abi_cache, function, &g_abi) ||
+        g_abi.args_size != function->args.args_size) {
+        return false;
+    }
+    for (size_t i = 0; i < g_abi.args_size; i++) {
+        if (!transaction_abi_arg_format(transaction, &g_abi, i, g_scratch, sizeof(g_scratch))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Display unknown entry function transaction with its descriptor:
+ * #1 screen : eye icon + "Review Transaction"
+ * #2 screen : display function name
+ * #3 screen : display each argument with its name as title
+ * #4 screen : display gas fee
+ * #5 screen : approve button
+ * #6 screen : reject button
+ */
+static int ui_display_tx_abi() {
+    static const ux_flow_step_t *flow[ABI_ARGS_MAX + 6];
+    TX_FLOW_CHECK(flow);
+    size_t n = 0;
+
+    flow[n++] = &ux_display_review_step;
+    flow[n++] = &ux_display_function_step;
+    for (size_t i = 0; i < g_abi.args_size; i++) {
+        flow[n++] = ux_display_abi_arg_steps[i];
+    }
+    flow[n++] = &ux_display_gas_fee_step;
+    flow[n++] = &ux_display_approve_step;
+    flow[n++] = &ux_display_reject_step;
+    flow[n] = FLOW_END_STEP;
+
+    return ui_display_tx_flow(flow);
+}
+#endif
+
 int ui_display_entry_function() {
-    entry_function_payload_t *function = &G_context.tx_info.transaction.payload.entry_function;
-
-    memset(g_function, 0, sizeof(g_function));
-    snprintf(g_function,
-             sizeof(g_function),
-             "0x%.*H::%.*s::%.*s",
-             UI_MODULE_ADDRESS_LEN,
-             function->module_id.address + ADDRESS_LEN - UI_MODULE_ADDRESS_LEN,
-             function->module_id.name.len,
-             function->module_id.name.bytes,
-             function->function_name.len,
-             function->function_name.bytes);
-    PRINTF("Function: %s\n", g_function);
+    const transaction_t *transaction = &G_context.tx_info.transaction;
+    const entry_function_payload_t *function = &transaction->payload.entry_function;
+
+#ifdef HAVE_ABI_DESCRIPTORS
+    // arguments typed by a trusted descriptor are reviewed instead of the hash
+    if (ui_abi_lookup()) {
+        return ui_display_tx_abi();
+    }
+#endif
 
     switch (function->known_type) {
         case FUNC_APTOS_ACCOUNT_TRANSFER:
             return ui_display_tx_aptos_account_transfer();
         case FUNC_COIN_TRANSFER:
+        case FUNC_APTOS_ACCOUNT_TRANSFER_COINS:
             return ui_display_tx_coin_transfer();
+        case FUNC_COIN_REGISTER:
+            return ui_display_tx_coin_register();
+        case FUNC_STAKE_ADD_STAKE:
+        case FUNC_STAKE_UNLOCK:
+        case FUNC_STAKE_WITHDRAW:
+            return ui_display_tx_stake();
+        case FUNC_DELEGATION_POOL_ADD_STAKE:
+        case FUNC_DELEGATION_POOL_UNLOCK:
+        case FUNC_DELEGATION_POOL_REACTIVATE_STAKE:
+        case FUNC_DELEGATION_POOL_WITHDRAW:
+            return ui_display_tx_delegation_pool();
         default:
-            ux_flow_init(0, ux_display_tx_entry_function_flow, NULL);
             break;
     }
-    return 0;
+
+    // arguments of the call are not formatted, it is only signed by users who
+    // enabled blind signing
+    if (!N_storage.blind_signing) {
+        PRINTF("Blind signing disabled\n");
+        G_context.state = STATE_NONE;
+        return io_send_sw(SW_BLIND_SIGNING_DISABLED);
+    }
+
+    return ui_display_tx_flow(ux_display_tx_blind_flow);
 }
 
 int ui_display_tx_aptos_account_transfer() {
-    agrs_aptos_account_trasfer_t *transfer =
-        &G_context.tx_info.transaction.payload.entry_function.args.transfer;
+    return ui_display_tx_flow(ux_display_tx_aptos_account_transfer_flow);
+}
 
-    memset(g_address, 0, sizeof(g_address));
-    snprintf(g_address, sizeof(g_address), "0x%.*H", ADDRESS_LEN, transfer->receiver);
-    PRINTF("Receiver: %s\n", g_address);
+/**
+ * Whether the coin type of the transaction under review fits in g_scratch,
+ * a generic coin type is never shown cut.
+ */
+static bool ui_coin_type_check() {
+    return transaction_field_format(&G_context.tx_info.transaction,
+                                    TX_FIELD_COIN_TYPE,
+                                    NULL,
+                                    g_scratch,
+                                    sizeof(g_scratch));
+}
 
-    memset(g_amount, 0, sizeof(g_amount));
-    char amount[30] = {0};
-    if (!format_fpu64(amount, sizeof(amount), transfer->amount, 8)) {
-        return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
+int ui_display_tx_coin_transfer() {
+    if (!ui_coin_type_check()) {
+        G_context.state = STATE_NONE;
+        return io_send_sw(SW_TX_PARSING_FAIL);
     }
-    snprintf(g_amount, sizeof(g_amount), "APT %.*s", sizeof(amount), amount);
-    PRINTF("Amount: %s\n", g_amount);
 
-    ux_flow_init(0, ux_display_tx_aptos_account_transfer_flow, NULL);
+    return ui_display_tx_flow(ux_display_tx_coin_transfer_flow);
+}
 
-    return 0;
+int ui_display_tx_coin_register() {
+    if (!ui_coin_type_check()) {
+        G_context.state = STATE_NONE;
+        return io_send_sw(SW_TX_PARSING_FAIL);
+    }
+
+    return ui_display_tx_flow(ux_display_tx_coin_register_flow);
 }
 
-int ui_display_tx_coin_transfer() {
-    agrs_coin_trasfer_t *transfer =
-        &G_context.tx_info.transaction.payload.entry_function.args.coin_transfer;
-
-    memset(g_struct, 0, sizeof(g_struct));
-    snprintf(g_struct,
-             sizeof(g_struct),
-             "0x%.*H..%.*H::%.*s::%.*s",
-             UI_MODULE_ADDRESS_LEN,
-             transfer->ty_coin.address,
-             UI_MODULE_ADDRESS_LEN,
-             transfer->ty_coin.address + ADDRESS_LEN - UI_MODULE_ADDRESS_LEN,
-             transfer->ty_coin.module_name.len,
-             transfer->ty_coin.module_name.bytes,
-             transfer->ty_coin.name.len,
-             transfer->ty_coin.name.bytes);
-    PRINTF("Coin Type: %s\n", g_struct);
-
-    memset(g_address, 0, sizeof(g_address));
-    snprintf(g_address, sizeof(g_address), "0x%.*H", ADDRESS_LEN, transfer->receiver);
-    PRINTF("Receiver: %s\n", g_address);
-
-    memset(g_amount, 0, sizeof(g_amount));
-    if (!format_fpu64(g_amount, sizeof(g_amount), transfer->amount, 8)) {
-        return io_send_sw(SW_DISPLAY_AMOUNT_FAIL);
+int ui_display_tx_stake() {
+    return ui_display_tx_flow(ux_display_tx_stake_flow);
+}
+
+int ui_display_tx_delegation_pool() {
+    return ui_display_tx_flow(ux_display_tx_delegation_pool_flow);
+}
+
+/**
+ * Format "APT" amount of the batch under review in g_scratch.
+ */
+static void ui_render_batch_amount(uint64_t value) {
+    char amount[30] = {0};
+
+    memset(g_scratch, 0, sizeof(g_scratch));
+    format_fpu64(amount, sizeof(amount), value, 8);
+    snprintf(g_scratch, sizeof(g_scratch), "APT %.*s", sizeof(amount), amount);
+}
+
+/**
+ * Format number of transactions of the batch under review in g_scratch.
+ */
+static void ui_render_batch_tx_count() {
+    memset(g_scratch, 0, sizeof(g_scratch));
+    format_u64(g_scratch, sizeof(g_scratch), G_context.batch_info.tx_count);
+}
+
+/**
+ * Format sender address of the batch under review in g_scratch.
+ */
+static void ui_render_batch_sender() {
+    memset(g_scratch, 0, sizeof(g_scratch));
+    snprintf(g_scratch, sizeof(g_scratch), "0x%.*H", ADDRESS_LEN, G_context.batch_info.sender);
+}
+
+// Step with icon and text
+UX_STEP_NOCB(ux_display_review_batch_step,
+             pnn,
+             {
+                 &C_icon_eye,
+                 "Review",
+                 "Batch",
+             });
+// Step with title/text for number of transactions
+UX_STEP_NOCB_INIT(ux_display_tx_count_step,
+                  bnnn_paging,
+                  ui_render_batch_tx_count(),
+                  {
+                      .title = "Transactions",
+                      .text = g_scratch,
+                  });
+// Step with title/text for sender
+UX_STEP_NOCB_INIT(ux_display_sender_step,
+                  bnnn_paging,
+                  ui_render_batch_sender(),
+                  {
+                      .title = "Sender",
+                      .text = g_scratch,
+                  });
+// Step with title/text for total amount
+UX_STEP_NOCB_INIT(ux_display_total_amount_step,
+                  bnnn_paging,
+                  ui_render_batch_amount(G_context.batch_info.total_amount),
+                  {
+                      .title = "Total Amount",
+                      .text = g_scratch,
+                  });
+// Step with title/text for maximum gas fee
+UX_STEP_NOCB_INIT(ux_display_max_gas_fee_step,
+                  bnnn_paging,
+                  ui_render_batch_amount(G_context.batch_info.max_gas_fee),
+                  {
+                      .title = "Max Gas Fee",
+                      .text = g_scratch,
+                  });
+
+// FLOW to display batch information:
+// #1 screen : eye icon + "Review Batch"
+// #2 screen : display number of transactions
+// #3 screen : display sender address
+// #4 screen : display total amount
+// #5 screen : display maximum gas fee per transaction
+// #6 screen : approve button
+// #7 screen : reject button
+UX_FLOW(ux_display_batch_flow,
+        &ux_display_review_batch_step,
+        &ux_display_tx_count_step,
+        &ux_display_sender_step,
+        &ux_display_total_amount_step,
+        &ux_display_max_gas_fee_step,
+        &ux_display_approve_step,
+        &ux_display_reject_step);
+
+int ui_display_batch() {
+    if (G_context.req_type != CONFIRM_BATCH || G_context.state != STATE_NONE) {
+        G_context.state = STATE_NONE;
+        return io_send_sw(SW_BAD_STATE);
     }
-    PRINTF("Amount: %s\n", g_amount);
 
-    ux_flow_init(0, ux_display_tx_coin_transfer_flow, NULL);
+    g_validate_callback = &ui_action_validate_batch;
+
+    ux_flow_init(0, ux_display_batch_flow, NULL);
 
     return 0;
 }
@@ -2,8 +2,6 @@
 
 #include <stdbool.h>  // bool
 
-#define UI_MODULE_ADDRESS_LEN 1
-
 /**
  * Callback to reuse action with approve/reject in step FLOW.
  */
@@ -25,10 +23,27 @@ int ui_display_address(void);
  */
 int ui_display_transaction(void);
 
+/**
+ * Display batch limits on the device and ask confirmation to sign
+ * the transactions of the batch.
+ *
+ * @return 0 if success, negative integer otherwise.
+ *
+ */
+int ui_display_batch(void);
+
 int ui_display_message(void);
 
+int ui_display_script(void);
+
 int ui_display_entry_function(void);
 
 int ui_display_tx_aptos_account_transfer(void);
 
 int ui_display_tx_coin_transfer(void);
+
+int ui_display_tx_coin_register(void);
+
+int ui_display_tx_stake(void);
+
+int ui_display_tx_delegation_pool(void);
@@ -20,21 +20,36 @@
 #include "glyphs.h"
 
 #include "../globals.h"
+#include "../crypto.h"
+#include "../settings.h"
+#include "../handler/sign_tx_batch.h"
 #include "menu.h"
 
+/**
+ * Wipe cached keys and go back to the dashboard.
+ */
+static void ui_menu_exit() {
+    crypto_clear_public_key_cache();
+    sign_tx_batch_wipe();
+    os_sched_exit(-1);
+}
+
 UX_STEP_NOCB(ux_menu_ready_step, pnn, {&C_aptos_logo, "Aptos", "is ready"});
 UX_STEP_NOCB(ux_menu_version_step, bn, {"Version", APPVERSION});
+UX_STEP_CB(ux_menu_settings_step, pb, ui_menu_settings(0), {&C_icon_coggle, "Settings"});
 UX_STEP_CB(ux_menu_about_step, pb, ui_menu_about(), {&C_icon_certificate, "About"});
-UX_STEP_VALID(ux_menu_exit_step, pb, os_sched_exit(-1), {&C_icon_dashboard_x, "Quit"});
+UX_STEP_VALID(ux_menu_exit_step, pb, ui_menu_exit(), {&C_icon_dashboard_x, "Quit"});
 
 // FLOW for the main menu:
 // #1 screen: ready
 // #2 screen: version of the app
-// #3 screen: about submenu
-// #4 screen: quit
+// #3 screen: settings submenu
+// #4 screen: about submenu
+// #5 screen: quit
 UX_FLOW(ux_menu_main_flow,
         &ux_menu_ready_step,
         &ux_menu_version_step,
+        &ux_menu_settings_step,
         &ux_menu_about_step,
         &ux_menu_exit_step,
         FLOW_LOOP);
@@ -58,3 +73,55 @@ UX_FLOW(ux_menu_about_flow, &ux_menu_info_step, &ux_menu_back_step, FLOW_LOOP);
 void ui_menu_about() {
     ux_flow_init(0, ux_menu_about_flow, NULL);
 }
+
+static char g_blind_signing[9];
+static char g_expert_mode[9];
+
+/**
+ * Flip the blind signing setting in NVM and show the settings again.
+ */
+static void ui_menu_toggle_blind_signing() {
+    settings_set_blind_signing(!N_storage.blind_signing);
+    ui_menu_settings(0);
+}
+
+/**
+ * Flip the expert mode setting in NVM and show the settings again.
+ */
+static void ui_menu_toggle_expert_mode() {
+    settings_set_expert_mode(!N_storage.expert_mode);
+    ui_menu_settings(1);
+}
+
+UX_STEP_CB(ux_menu_blind_signing_step,
+           bn,
+           ui_menu_toggle_blind_signing(),
+           {"Blind signing", g_blind_signing});
+UX_STEP_CB(ux_menu_expert_mode_step,
+           bn,
+           ui_menu_toggle_expert_mode(),
+           {"Expert mode", g_expert_mode});
+UX_STEP_CB(ux_menu_settings_back_step, pb, ui_menu_main(), {&C_icon_back, "Back"});
+
+// FLOW for the settings submenu:
+// #1 screen: blind signing of unknown entry functions, toggled on click
+// #2 screen: expert mode (full message hash), toggled on click
+// #3 screen: back button to main menu
+UX_FLOW(ux_menu_settings_flow,
+        &ux_menu_blind_signing_step,
+        &ux_menu_expert_mode_step,
+        &ux_menu_settings_back_step,
+        FLOW_LOOP);
+
+void ui_menu_settings(uint8_t step) {
+    snprintf(g_blind_signing,
+             sizeof(g_blind_signing),
+             "%s",
+             N_storage.blind_signing ? "Enabled" : "Disabled");
+    snprintf(g_expert_mode,
+             sizeof(g_expert_mode),
+             "%s",
+             N_storage.expert_mode ? "Enabled" : "Disabled");
+
+    ux_flow_init(0, ux_menu_settings_flow, ux_menu_settings_flow[step]);
+}
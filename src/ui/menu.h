@@ -1,7 +1,9 @@
 #pragma once
 
+#include <stdint.h>  // uint*_t
+
 /**
- * Show main menu (ready screen, version, about, quit).
+ * Show main menu (ready screen, version, settings, about, quit).
  */
 void ui_menu_main(void);
 
@@ -9,3 +11,12 @@ void ui_menu_main(void);
  * Show about submenu (copyright, date).
  */
 void ui_menu_about(void);
+
+/**
+ * Show settings submenu (blind signing, expert mode).
+ *
+ * @param[in] step
+ *   Index of the step shown first.
+ *
+ */
+void ui_menu_settings(uint8_t step);
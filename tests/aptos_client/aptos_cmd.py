@@ -1,9 +1,9 @@
 import struct
-from typing import Tuple
+from typing import List, Tuple
 
 from ledgercomm import Transport
 
-from aptos_client.aptos_cmd_builder import AptosCommandBuilder, InsType
+from aptos_client.aptos_cmd_builder import AptosCommandBuilder, InsType, MAX_APDU_LEN
 from aptos_client.button import Button
 from aptos_client.exception import DeviceException
 
@@ -11,9 +11,10 @@ from aptos_client.exception import DeviceException
 class AptosCommand:
     def __init__(self,
                  transport: Transport,
-                 debug: bool = False) -> None:
+                 debug: bool = False,
+                 chunk_len: int = MAX_APDU_LEN) -> None:
         self.transport = transport
-        self.builder = AptosCommandBuilder(debug=debug)
+        self.builder = AptosCommandBuilder(debug=debug, chunk_len=chunk_len)
         self.debug = debug
 
     def get_app_and_version(self) -> Tuple[str, str]:
@@ -100,7 +101,128 @@ class AptosCommand:
 
         return pub_key, chain_code
 
-    def sign_raw(self, bip32_path: str, data: bytes, button: Button, model: str) -> Tuple[int, bytes]:
+    def get_public_key_and_address(self, bip32_path: str) -> Tuple[bytes, bytes, bytes]:
+        sw, response = self.transport.exchange_raw(
+            self.builder.get_public_key(bip32_path=bip32_path,
+                                        display=False,
+                                        with_address=True)
+        )  # type: int, bytes
+
+        if sw != 0x9000:
+            raise DeviceException(error_code=sw, ins=InsType.INS_GET_PUBLIC_KEY)
+
+        # response = pub_key_len (1) ||
+        #            pub_key (var) ||
+        #            chain_code_len (1) ||
+        #            chain_code (var) ||
+        #            address_len (1) ||
+        #            address (var)
+        offset: int = 0
+
+        pub_key_len: int = response[offset]
+        offset += 1
+        pub_key: bytes = response[offset:offset + pub_key_len]
+        offset += pub_key_len
+        chain_code_len: int = response[offset]
+        offset += 1
+        chain_code: bytes = response[offset:offset + chain_code_len]
+        offset += chain_code_len
+        address_len: int = response[offset]
+        offset += 1
+        address: bytes = response[offset:offset + address_len]
+        offset += address_len
+
+        assert len(response) == 1 + pub_key_len + 1 + chain_code_len + 1 + address_len
+
+        return pub_key, chain_code, address
+
+    def get_public_keys(self,
+                        bip32_path: str,
+                        index_position: int,
+                        start: int,
+                        count: int,
+                        addresses: bool = False) -> List[bytes]:
+        sw, response = self.transport.exchange_raw(
+            self.builder.get_public_keys(bip32_path=bip32_path,
+                                         index_position=index_position,
+                                         start=start,
+                                         count=count,
+                                         addresses=addresses)
+        )  # type: int, bytes
+
+        if sw != 0x9000:
+            raise DeviceException(error_code=sw, ins=InsType.INS_GET_PUBLIC_KEYS)
+
+        # response = count (1) ||
+        #            (pub_key | address) (32) * count
+        assert len(response) == 1 + 32 * response[0]
+
+        return [response[1 + 32 * i:1 + 32 * (i + 1)] for i in range(response[0])]
+
+    def get_settings(self) -> Tuple[int, int, int, int, int]:
+        sw, response = self.transport.exchange_raw(
+            self.builder.get_settings()
+        )  # type: int, bytes
+
+        if sw != 0x9000:
+            raise DeviceException(error_code=sw, ins=InsType.INS_GET_SETTINGS)
+
+        # response = version (1) || flags (1) || account_index (4) ||
+        #            max_cdata_len (2) || max_tx_len (2)
+        assert len(response) == 10
+
+        return struct.unpack(">BBIHH", response)  # type: ignore
+
+    def provide_abi(self, descriptor: bytes, signature: bytes) -> bytes:
+        sw, response = self.transport.exchange_raw(
+            self.builder.provide_abi(descriptor=descriptor, signature=signature)
+        )  # type: int, bytes
+
+        if sw != 0x9000:
+            raise DeviceException(error_code=sw, ins=InsType.INS_PROVIDE_ABI)
+
+        # response = SHA3-256 of descriptor (32)
+        assert len(response) == 32
+
+        return response
+
+    def check_abi(self, digest: bytes) -> bool:
+        sw, response = self.transport.exchange_raw(
+            self.builder.check_abi(digest=digest)
+        )  # type: int, bytes
+
+        if sw != 0x9000:
+            raise DeviceException(error_code=sw, ins=InsType.INS_PROVIDE_ABI)
+
+        # response = cached (1)
+        assert len(response) == 1
+
+        return response[0] == 1
+
+    def get_profile(self) -> Tuple[int, int, List[Tuple[int, bool, int, int]]]:
+        sw, response = self.transport.exchange_raw(
+            self.builder.get_profile()
+        )  # type: int, bytes
+
+        if sw != 0x9000:
+            raise DeviceException(error_code=sw, ins=InsType.INS_GET_PROFILE)
+
+        # response = stack_size (2) || stack_used (2) || count (1) ||
+        #            count * (stage (1) || end (1) || stack_used (2) || ticks (4))
+        stack_size, stack_used, count = struct.unpack(">HHB", response[:5])
+        assert len(response) == 5 + 8 * count
+
+        records: List[Tuple[int, bool, int, int]] = []
+        for i in range(count):
+            stage, end, record_stack_used, ticks = struct.unpack(
+                ">BBHI",
+                response[5 + 8 * i:5 + 8 * (i + 1)]
+            )
+            records.append((stage, bool(end), record_stack_used, ticks))
+
+        return stack_size, stack_used, records
+
+    def sign_raw(self, bip32_path: str, data: bytes, button: Button, model: str) -> Tuple[bytes, bytes]:
         sw: int
         response: bytes = b""
 
@@ -128,6 +250,11 @@ class AptosCommand:
                 button.right_click()
                 # Gas Fee
                 button.right_click()
+                # Message Hash
+                # Due to screen size, NanoS needs 1 more screen to display the fingerprint
+                if model == 'nanos':
+                    button.right_click()
+                button.right_click()
                 # Approve
                 button.both_click()
 
@@ -137,10 +264,90 @@ class AptosCommand:
                 raise DeviceException(error_code=sw, ins=InsType.INS_SIGN_TX)
 
         # response = der_sig_len (1) ||
-        #            der_sig (var)
-        der_sig_len: int = response[0]
-        der_sig: bytes = response[1: 1 + der_sig_len]
+        #            der_sig (var) ||
+        #            tx_hash_len (1) ||
+        #            message_hash (var)
+        offset: int = 0
+        der_sig_len: int = response[offset]
+        offset += 1
+        der_sig: bytes = response[offset:offset + der_sig_len]
+        offset += der_sig_len
+        tx_hash_len: int = response[offset]
+        offset += 1
+        message_hash: bytes = response[offset:offset + tx_hash_len]
+        offset += tx_hash_len
+
+        assert len(response) == offset
+
+        return der_sig, message_hash
+
+    def sign_batch(self,
+                   bip32_path: str,
+                   tx_count: int,
+                   total_amount: int,
+                   max_gas_fee: int,
+                   button: Button,
+                   model: str,
+                   approve: bool = True) -> None:
+        self.transport.send_raw(
+            self.builder.sign_batch(bip32_path=bip32_path,
+                                    tx_count=tx_count,
+                                    total_amount=total_amount,
+                                    max_gas_fee=max_gas_fee)
+        )
+
+        # Review Batch
+        button.right_click()
+        # Transactions
+        button.right_click()
+        # Sender
+        # Due to screen size, NanoS needs 2 more screens to display the address
+        if model == 'nanos':
+            button.right_click()
+            button.right_click()
+        button.right_click()
+        button.right_click()
+        # Total Amount
+        button.right_click()
+        # Max Gas Fee
+        button.right_click()
+        if approve:
+            # Approve
+            button.both_click()
+        else:
+            # Reject
+            button.right_click()
+            button.both_click()
+
+        sw, _ = self.transport.recv()  # type: int, bytes
+
+        if sw != 0x9000:
+            raise DeviceException(error_code=sw, ins=InsType.INS_SIGN_TX_BATCH)
+
+    def sign_batch_tx(self, data: bytes) -> Tuple[bytes, bytes]:
+        sw: int
+        response: bytes = b""
+
+        for _, chunk in self.builder.sign_batch_raw(data=data):
+            sw, response = self.transport.exchange_raw(chunk)  # type: int, bytes
+
+            if sw != 0x9000:
+                raise DeviceException(error_code=sw, ins=InsType.INS_SIGN_TX_BATCH)
+
+        # response = der_sig_len (1) ||
+        #            der_sig (var) ||
+        #            tx_hash_len (1) ||
+        #            message_hash (var)
+        offset: int = 0
+        der_sig_len: int = response[offset]
+        offset += 1
+        der_sig: bytes = response[offset:offset + der_sig_len]
+        offset += der_sig_len
+        tx_hash_len: int = response[offset]
+        offset += 1
+        message_hash: bytes = response[offset:offset + tx_hash_len]
+        offset += tx_hash_len
 
-        assert len(response) == 1 + der_sig_len
+        assert len(response) == offset
 
-        return der_sig
+        return der_sig, message_hash
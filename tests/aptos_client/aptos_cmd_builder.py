@@ -6,6 +6,8 @@ from typing import List, Tuple, Union, Iterator, cast
 from aptos_client.utils import bip32_path_from_string
 
 MAX_APDU_LEN: int = 255
+# Command data of an extended APDU on devices other than Nano S
+MAX_EXT_APDU_LEN: int = 1024
 
 
 def chunkify(data: bytes, chunk_len: int) -> Iterator[Tuple[bool, bytes]]:
@@ -32,6 +34,11 @@ class InsType(enum.IntEnum):
     INS_GET_APP_NAME = 0x04
     INS_GET_PUBLIC_KEY = 0x05
     INS_SIGN_TX = 0x06
+    INS_SIGN_TX_BATCH = 0x07
+    INS_GET_PUBLIC_KEYS = 0x08
+    INS_GET_SETTINGS = 0x09
+    INS_PROVIDE_ABI = 0x0A
+    INS_GET_PROFILE = 0xF0
 
 
 class AptosCommandBuilder:
@@ -41,18 +48,24 @@ class AptosCommandBuilder:
     ----------
     debug: bool
         Whether you want to see logging or not.
+    chunk_len: int
+        Maximum command data length of transaction chunks, above
+        MAX_APDU_LEN chunks are sent as extended APDUs.
 
     Attributes
     ----------
     debug: bool
         Whether you want to see logging or not.
+    chunk_len: int
+        Maximum command data length of transaction chunks.
 
     """
     CLA: int = 0x5B
 
-    def __init__(self, debug: bool = False):
+    def __init__(self, debug: bool = False, chunk_len: int = MAX_APDU_LEN):
         """Init constructor."""
         self.debug = debug
+        self.chunk_len = chunk_len
 
     def serialize(self,
                   cla: int,
@@ -83,12 +96,13 @@ class AptosCommandBuilder:
         """
         ins = cast(int, ins.value) if isinstance(ins, enum.IntEnum) else cast(int, ins)
 
-        header: bytes = struct.pack("BBBBB",
-                                    cla,
-                                    ins,
-                                    p1,
-                                    p2,
-                                    len(cdata))  # add Lc to APDU header
+        header: bytes = struct.pack("BBBB", cla, ins, p1, p2)
+
+        # add Lc to APDU header, extended (0x00 || 2 bytes) above 255 bytes
+        if len(cdata) > MAX_APDU_LEN:
+            header += struct.pack(">BH", 0, len(cdata))
+        else:
+            header += struct.pack("B", len(cdata))
 
         if self.debug:
             logging.info("header: %s", header.hex())
@@ -141,7 +155,10 @@ class AptosCommandBuilder:
                               p2=0x00,
                               cdata=b"")
 
-    def get_public_key(self, bip32_path: str, display: bool = False) -> bytes:
+    def get_public_key(self,
+                       bip32_path: str,
+                       display: bool = False,
+                       with_address: bool = False) -> bytes:
         """Command builder for GET_PUBLIC_KEY.
 
         Parameters
@@ -150,6 +167,8 @@ class AptosCommandBuilder:
             String representation of BIP32 path.
         display : bool
             Whether you want to display the address on the device.
+        with_address : bool
+            Whether you want the address appended to the response.
 
         Returns
         -------
@@ -167,9 +186,124 @@ class AptosCommandBuilder:
         return self.serialize(cla=self.CLA,
                               ins=InsType.INS_GET_PUBLIC_KEY,
                               p1=0x01 if display else 0x00,
+                              p2=0x01 if with_address else 0x00,
+                              cdata=cdata)
+
+    def get_public_keys(self,
+                        bip32_path: str,
+                        index_position: int,
+                        start: int,
+                        count: int,
+                        addresses: bool = False) -> bytes:
+        """Command builder for GET_PUBLIC_KEYS.
+
+        Parameters
+        ----------
+        bip32_path : str
+            String representation of base BIP32 path.
+        index_position : int
+            Position of the index component in the BIP32 path.
+        start : int
+            First index of the range.
+        count : int
+            Number of indices in the range.
+        addresses : bool
+            Whether to get addresses instead of public keys.
+
+        Returns
+        -------
+        bytes
+            APDU command for GET_PUBLIC_KEYS.
+
+        """
+        bip32_paths: List[bytes] = bip32_path_from_string(bip32_path)
+
+        cdata: bytes = b"".join([
+            len(bip32_paths).to_bytes(1, byteorder="big"),
+            *bip32_paths,
+            index_position.to_bytes(1, byteorder="big"),
+            start.to_bytes(4, byteorder="big"),
+            count.to_bytes(1, byteorder="big")
+        ])
+
+        return self.serialize(cla=self.CLA,
+                              ins=InsType.INS_GET_PUBLIC_KEYS,
+                              p1=0x01 if addresses else 0x00,
                               p2=0x00,
                               cdata=cdata)
 
+    def get_settings(self) -> bytes:
+        """Command builder for GET_SETTINGS.
+
+        Returns
+        -------
+        bytes
+            APDU command for GET_SETTINGS.
+
+        """
+        return self.serialize(cla=self.CLA,
+                              ins=InsType.INS_GET_SETTINGS,
+                              p1=0x00,
+                              p2=0x00,
+                              cdata=b"")
+
+    def provide_abi(self, descriptor: bytes, signature: bytes) -> bytes:
+        """Command builder for PROVIDE_ABI (only with ABI_SIGNER_KEY or ABI_TEST_KEY).
+
+        Parameters
+        ----------
+        descriptor : bytes
+            Descriptor body of an entry function.
+        signature : bytes
+            Ed25519 signature of the descriptor body.
+
+        Returns
+        -------
+        bytes
+            APDU command for PROVIDE_ABI.
+
+        """
+        return self.serialize(cla=self.CLA,
+                              ins=InsType.INS_PROVIDE_ABI,
+                              p1=0x00,
+                              p2=0x00,
+                              cdata=descriptor + signature)
+
+    def check_abi(self, digest: bytes) -> bytes:
+        """Command builder for PROVIDE_ABI to check a cached descriptor.
+
+        Parameters
+        ----------
+        digest : bytes
+            SHA3-256 of the descriptor body.
+
+        Returns
+        -------
+        bytes
+            APDU command for PROVIDE_ABI.
+
+        """
+        return self.serialize(cla=self.CLA,
+                              ins=InsType.INS_PROVIDE_ABI,
+                              p1=0x01,
+                              p2=0x00,
+                              cdata=digest)
+
+    def get_profile(self) -> bytes:
+        """Command builder for GET_PROFILE (only with PROFILING=1).
+
+        Returns
+        -------
+        bytes
+            APDU command for GET_PROFILE.
+
+        """
+        return self.serialize(cla=self.CLA,
+                              ins=InsType.INS_GET_PROFILE,
+                              p1=0x00,
+                              p2=0x00,
+                              cdata=b"")
+
     def sign_raw(self, bip32_path: str, data: bytes) -> Iterator[Tuple[bool, bytes]]:
         """Command builder for INS_SIGN_TX.
 
@@ -199,7 +333,7 @@ class AptosCommandBuilder:
                                     p2=0x80,
                                     cdata=cdata)
 
-        for i, (is_last, chunk) in enumerate(chunkify(data, MAX_APDU_LEN)):
+        for i, (is_last, chunk) in enumerate(chunkify(data, self.chunk_len)):
             if is_last:
                 yield True, self.serialize(cla=self.CLA,
                                            ins=InsType.INS_SIGN_TX,
@@ -213,3 +347,64 @@ class AptosCommandBuilder:
                                             p1=i + 1,
                                             p2=0x80,
                                             cdata=chunk)
+
+    def sign_batch(self,
+                   bip32_path: str,
+                   tx_count: int,
+                   total_amount: int,
+                   max_gas_fee: int) -> bytes:
+        """Command builder for INS_SIGN_TX_BATCH limits.
+
+        Parameters
+        ----------
+        bip32_path : str
+            String representation of BIP32 path.
+        tx_count : int
+            Number of transactions in the batch.
+        total_amount : int
+            Total amount of APT (in octas) transferred by the batch.
+        max_gas_fee : int
+            Maximum gas fee (in octas) of each transaction of the batch.
+
+        Returns
+        -------
+        bytes
+            APDU command for INS_SIGN_TX_BATCH limits.
+
+        """
+        bip32_paths: List[bytes] = bip32_path_from_string(bip32_path)
+
+        cdata: bytes = b"".join([
+            len(bip32_paths).to_bytes(1, byteorder="big"),
+            *bip32_paths,
+            tx_count.to_bytes(4, byteorder="big"),
+            total_amount.to_bytes(8, byteorder="big"),
+            max_gas_fee.to_bytes(8, byteorder="big")
+        ])
+
+        return self.serialize(cla=self.CLA,
+                              ins=InsType.INS_SIGN_TX_BATCH,
+                              p1=0x00,
+                              p2=0x00,
+                              cdata=cdata)
+
+    def sign_batch_raw(self, data: bytes) -> Iterator[Tuple[bool, bytes]]:
+        """Command builder for INS_SIGN_TX_BATCH transaction.
+
+        Parameters
+        ----------
+        data : bytes
+            Representation of the transaction data to be signed.
+
+        Yields
+        -------
+        bytes
+            APDU command chunk for INS_SIGN_TX_BATCH.
+
+        """
+        for i, (is_last, chunk) in enumerate(chunkify(data, self.chunk_len)):
+            yield is_last, self.serialize(cla=self.CLA,
+                                          ins=InsType.INS_SIGN_TX_BATCH,
+                                          p1=i + 1,
+                                          p2=0x00 if is_last else 0x80,
+                                          cdata=chunk)
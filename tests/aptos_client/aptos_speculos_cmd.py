@@ -1,5 +1,5 @@
 import struct
-from typing import Tuple
+from typing import List, Tuple
 
 from speculos.client import SpeculosClient, ApduException
 
@@ -102,7 +102,134 @@ class AptosSpeculosCommand:
 
         return pub_key, chain_code
 
-    def sign_raw(self, bip32_path: str, data: bytes, model: str) -> Tuple[int, bytes]:
+    def get_public_key_and_address(self, bip32_path: str) -> Tuple[bytes, bytes, bytes]:
+        try:
+            response = self.client._apdu_exchange(
+                self.builder.get_public_key(bip32_path=bip32_path,
+                                            display=False,
+                                            with_address=True)
+            )  # type: int, bytes
+        except ApduException as error:
+            raise DeviceException(error_code=error.sw,
+                                  ins=InsType.INS_GET_PUBLIC_KEY)
+
+        # response = pub_key_len (1) ||
+        #            pub_key (var) ||
+        #            chain_code_len (1) ||
+        #            chain_code (var) ||
+        #            address_len (1) ||
+        #            address (var)
+        offset: int = 0
+
+        pub_key_len: int = response[offset]
+        offset += 1
+        pub_key: bytes = response[offset:offset + pub_key_len]
+        offset += pub_key_len
+        chain_code_len: int = response[offset]
+        offset += 1
+        chain_code: bytes = response[offset:offset + chain_code_len]
+        offset += chain_code_len
+        address_len: int = response[offset]
+        offset += 1
+        address: bytes = response[offset:offset + address_len]
+        offset += address_len
+
+        assert len(response) == 1 + pub_key_len + 1 + chain_code_len + 1 + address_len
+
+        return pub_key, chain_code, address
+
+    def get_public_keys(self,
+                        bip32_path: str,
+                        index_position: int,
+                        start: int,
+                        count: int,
+                        addresses: bool = False) -> List[bytes]:
+        try:
+            response = self.client._apdu_exchange(
+                self.builder.get_public_keys(bip32_path=bip32_path,
+                                             index_position=index_position,
+                                             start=start,
+                                             count=count,
+                                             addresses=addresses)
+            )  # type: int, bytes
+        except ApduException as error:
+            raise DeviceException(error_code=error.sw,
+                                  ins=InsType.INS_GET_PUBLIC_KEYS)
+
+        # response = count (1) ||
+        #            (pub_key | address) (32) * count
+        assert len(response) == 1 + 32 * response[0]
+
+        return [response[1 + 32 * i:1 + 32 * (i + 1)] for i in range(response[0])]
+
+    def get_settings(self) -> Tuple[int, int, int, int, int]:
+        try:
+            response = self.client._apdu_exchange(
+                self.builder.get_settings()
+            )  # type: int, bytes
+        except ApduException as error:
+            raise DeviceException(error_code=error.sw,
+                                  ins=InsType.INS_GET_SETTINGS)
+
+        # response = version (1) || flags (1) || account_index (4) ||
+        #            max_cdata_len (2) || max_tx_len (2)
+        assert len(response) == 10
+
+        return struct.unpack(">BBIHH", response)  # type: ignore
+
+    def provide_abi(self, descriptor: bytes, signature: bytes) -> bytes:
+        try:
+            response = self.client._apdu_exchange(
+                self.builder.provide_abi(descriptor=descriptor, signature=signature)
+            )  # type: int, bytes
+        except ApduException as error:
+            raise DeviceException(error_code=error.sw,
+                                  ins=InsType.INS_PROVIDE_ABI)
+
+        # response = SHA3-256 of descriptor (32)
+        assert len(response) == 32
+
+        return response
+
+    def check_abi(self, digest: bytes) -> bool:
+        try:
+            response = self.client._apdu_exchange(
+                self.builder.check_abi(digest=digest)
+            )  # type: int, bytes
+        except ApduException as error:
+            raise DeviceException(error_code=error.sw,
+                                  ins=InsType.INS_PROVIDE_ABI)
+
+        # response = cached (1)
+        assert len(response) == 1
+
+        return response[0] == 1
+
+    def get_profile(self) -> Tuple[int, int, List[Tuple[int, bool, int, int]]]:
+        try:
+            response = self.client._apdu_exchange(
+                self.builder.get_profile()
+            )  # type: int, bytes
+        except ApduException as error:
+            raise DeviceException(error_code=error.sw,
+                                  ins=InsType.INS_GET_PROFILE)
+
+        # response = stack_size (2) || stack_used (2) || count (1) ||
+        #            count * (stage (1) || end (1) || stack_used (2) || ticks (4))
+        stack_size, stack_used, count = struct.unpack(">HHB", response[:5])
+        assert len(response) == 5 + 8 * count
+
+        records: List[Tuple[int, bool, int, int]] = []
+        for i in range(count):
+            stage, end, record_stack_used, ticks = struct.unpack(
+                ">BBHI",
+                response[5 + 8 * i:5 + 8 * (i + 1)]
+            )
+            records.append((stage, bool(end), record_stack_used, ticks))
+
+        return stack_size, stack_used, records
+
+    def sign_raw(self, bip32_path: str, data: bytes, model: str) -> Tuple[bytes, bytes]:
         response: bytes = b""
 
         for is_last, chunk in self.builder.sign_raw(bip32_path=bip32_path, data=data):
@@ -130,6 +257,11 @@ class AptosSpeculosCommand:
                     self.client.press_and_release('right')
                     # Gas Fee
                     self.client.press_and_release('right')
+                    # Message Hash
+                    # Due to screen size, NanoS needs 1 more screen to display the fingerprint
+                    if model == 'nanos':
+                        self.client.press_and_release('right')
+                    self.client.press_and_release('right')
                     # Approve
                     self.client.press_and_release('both')
                     response = exchange.receive()
@@ -138,10 +270,90 @@ class AptosSpeculosCommand:
                 print(response)
 
         # response = der_sig_len (1) ||
-        #            der_sig (var)
-        der_sig_len: int = response[0]
-        der_sig: bytes = response[1: 1 + der_sig_len]
+        #            der_sig (var) ||
+        #            tx_hash_len (1) ||
+        #            message_hash (var)
+        offset: int = 0
+        der_sig_len: int = response[offset]
+        offset += 1
+        der_sig: bytes = response[offset:offset + der_sig_len]
+        offset += der_sig_len
+        tx_hash_len: int = response[offset]
+        offset += 1
+        message_hash: bytes = response[offset:offset + tx_hash_len]
+        offset += tx_hash_len
+
+        assert len(response) == offset
+
+        return der_sig, message_hash
+
+    def sign_batch(self,
+                   bip32_path: str,
+                   tx_count: int,
+                   total_amount: int,
+                   max_gas_fee: int,
+                   model: str,
+                   approve: bool = True) -> None:
+        chunk = self.builder.sign_batch(bip32_path=bip32_path,
+                                        tx_count=tx_count,
+                                        total_amount=total_amount,
+                                        max_gas_fee=max_gas_fee)
+
+        try:
+            with self.client.apdu_exchange_nowait(cla=chunk[0], ins=chunk[1],
+                                                  p1=chunk[2], p2=chunk[3],
+                                                  data=chunk[5:]) as exchange:
+                # Review Batch
+                self.client.press_and_release('right')
+                # Transactions
+                self.client.press_and_release('right')
+                # Sender
+                # Due to screen size, NanoS needs 2 more screens to display the address
+                if model == 'nanos':
+                    self.client.press_and_release('right')
+                    self.client.press_and_release('right')
+                self.client.press_and_release('right')
+                self.client.press_and_release('right')
+                # Total Amount
+                self.client.press_and_release('right')
+                # Max Gas Fee
+                self.client.press_and_release('right')
+                if approve:
+                    # Approve
+                    self.client.press_and_release('both')
+                else:
+                    # Reject
+                    self.client.press_and_release('right')
+                    self.client.press_and_release('both')
+                exchange.receive()
+        except ApduException as error:
+            raise DeviceException(error_code=error.sw,
+                                  ins=InsType.INS_SIGN_TX_BATCH)
+
+    def sign_batch_tx(self, data: bytes) -> Tuple[bytes, bytes]:
+        response: bytes = b""
+
+        try:
+            for _, chunk in self.builder.sign_batch_raw(data=data):
+                response = self.client._apdu_exchange(chunk)
+        except ApduException as error:
+            raise DeviceException(error_code=error.sw,
+                                  ins=InsType.INS_SIGN_TX_BATCH)
+
+        # response = der_sig_len (1) ||
+        #            der_sig (var) ||
+        #            tx_hash_len (1) ||
+        #            message_hash (var)
+        offset: int = 0
+        der_sig_len: int = response[offset]
+        offset += 1
+        der_sig: bytes = response[offset:offset + der_sig_len]
+        offset += der_sig_len
+        tx_hash_len: int = response[offset]
+        offset += 1
+        message_hash: bytes = response[offset:offset + tx_hash_len]
+        offset += tx_hash_len
 
-        assert len(response) == 1 + der_sig_len
+        assert len(response) == offset
 
-        return der_sig
+        return der_sig, message_hash
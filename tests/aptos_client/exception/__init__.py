@@ -13,7 +13,11 @@ from .errors import (UnknownDeviceError,
                      TxParsingFailError,
                      TxHashFail,
                      BadStateError,
-                     SignatureFailError)
+                     SignatureFailError,
+                     BatchMismatchError,
+                     AbiDescriptorFailError,
+                     AbiSignatureFailError,
+                     BlindSigningDisabledError)
 
 __all__ = [
     "DeviceException",
@@ -31,5 +35,9 @@ __all__ = [
     "TxParsingFailError",
     "TxHashFail",
     "BadStateError",
-    "SignatureFailError"
+    "SignatureFailError",
+    "BatchMismatchError",
+    "AbiDescriptorFailError",
+    "AbiSignatureFailError",
+    "BlindSigningDisabledError"
 ]
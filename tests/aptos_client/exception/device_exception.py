@@ -19,7 +19,11 @@ class DeviceException(Exception):  # pylint: disable=too-few-public-methods
         0xB005: TxParsingFailError,
         0xB006: TxHashFail,
         0xB007: BadStateError,
-        0xB008: SignatureFailError
+        0xB008: SignatureFailError,
+        0xB009: BatchMismatchError,
+        0xB00A: AbiDescriptorFailError,
+        0xB00B: AbiSignatureFailError,
+        0xB00C: BlindSigningDisabledError
     }
 
     def __new__(cls,
@@ -56,3 +56,19 @@ class BadStateError(Exception):
 
 class SignatureFailError(Exception):
     pass
+
+
+class BatchMismatchError(Exception):
+    pass
+
+
+class AbiDescriptorFailError(Exception):
+    pass
+
+
+class AbiSignatureFailError(Exception):
+    pass
+
+
+class BlindSigningDisabledError(Exception):
+    pass
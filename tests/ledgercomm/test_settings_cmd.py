@@ -0,0 +1,11 @@
+def test_get_settings(cmd, model):
+    version, flags, account_index, max_cdata_len, max_tx_len = cmd.get_settings()
+
+    assert version == 1
+    # blind signing and expert mode are disabled by default
+    assert flags == 0
+    assert account_index == 0
+    if model == "nanos":
+        assert (max_cdata_len, max_tx_len) == (255, 510)
+    else:
+        assert (max_cdata_len, max_tx_len) == (1024, 4096)
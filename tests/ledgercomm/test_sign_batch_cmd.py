@@ -0,0 +1,197 @@
+import hashlib
+import struct
+
+import pytest
+from nacl.signing import VerifyKey
+from nacl.exceptions import BadSignatureError
+
+from aptos_client.exception import *
+
+
+BIP32_PATH: str = "m/44'/637'/1'/0'/0'"
+# prefix of the signing message of a RawTransaction
+RAW_TX_SALT = bytes.fromhex(
+    "b5e97db07fa0bd0e5598aa3643a9bc6f6693bddc1a9fec9e674a461eaa00b193"
+)
+FRAMEWORK = bytes(31) + b"\x01"
+RECEIVER = bytes.fromhex(
+    "094c6fc0d3b382a599c37e1aaa7618eff2c96a3586876082c4594c50c50d7dde"
+)
+
+
+def name(value: bytes) -> bytes:
+    return len(value).to_bytes(1, byteorder="big") + value
+
+
+def struct_tag(address: bytes, module: bytes, struct_name: bytes) -> bytes:
+    return b"\x07" + address + name(module) + name(struct_name) + b"\x00"
+
+
+APTOS_COIN = struct_tag(FRAMEWORK, b"aptos_coin", b"AptosCoin")
+OTHER_COIN = struct_tag(bytes(31) + b"\x2a", b"usdc", b"USDC")
+
+
+def transfer(sender: bytes,
+             sequence_number: int,
+             amount: int,
+             module: bytes = b"aptos_account",
+             function: bytes = b"transfer",
+             coin: bytes = b"",
+             max_gas_amount: int = 200,
+             gas_unit_price: int = 100,
+             chain_id: int = 2) -> bytes:
+    type_args = [coin] if coin else []
+    payload = b"".join([
+        b"\x02",  # EntryFunction
+        FRAMEWORK, name(module), name(function),
+        len(type_args).to_bytes(1, byteorder="big"), *type_args,
+        b"\x02", name(RECEIVER), name(struct.pack("<Q", amount))
+    ])
+    return b"".join([
+        RAW_TX_SALT,
+        sender,
+        struct.pack("<Q", sequence_number),
+        payload,
+        struct.pack("<QQQ", max_gas_amount, gas_unit_price, 0x63925c56),
+        chain_id.to_bytes(1, byteorder="big")
+    ])
+
+
+@pytest.fixture
+def account(cmd):
+    pub_key, _, address = cmd.get_public_key_and_address(
+        bip32_path=BIP32_PATH
+    )  # type: bytes, bytes, bytes
+
+    return VerifyKey(pub_key[1:]), address
+
+
+def test_sign_batch(cmd, button, model, account):
+    pk, sender = account
+    txs = [
+        transfer(sender, 10, 100_000_000),
+        transfer(sender, 11, 100_000_000, module=b"coin", coin=APTOS_COIN),
+        transfer(sender, 12, 100_000_000,
+                 function=b"transfer_coins", coin=APTOS_COIN),
+    ]
+
+    cmd.sign_batch(bip32_path=BIP32_PATH,
+                   tx_count=len(txs),
+                   total_amount=300_000_000,
+                   max_gas_fee=20_000,
+                   button=button,
+                   model=model)
+
+    for tx in txs:
+        der_sig, message_hash = cmd.sign_batch_tx(data=tx)
+
+        try:
+            pk.verify(signature=der_sig, smessage=tx)
+        except BadSignatureError as exc:
+            assert False, exc
+        assert message_hash == hashlib.sha3_256(tx).digest()
+
+    # the private key is wiped once the whole batch is signed
+    with pytest.raises(BadStateError):
+        cmd.sign_batch_tx(data=transfer(sender, 13, 1))
+
+
+def test_sign_batch_wrong_sender(cmd, button, model, account):
+    _, sender = account
+
+    cmd.sign_batch(bip32_path=BIP32_PATH,
+                   tx_count=2,
+                   total_amount=200,
+                   max_gas_fee=20_000,
+                   button=button,
+                   model=model)
+
+    with pytest.raises(BatchMismatchError):
+        cmd.sign_batch_tx(data=transfer(RECEIVER, 10, 100))
+    # the whole batch is aborted
+    with pytest.raises(BadStateError):
+        cmd.sign_batch_tx(data=transfer(sender, 10, 100))
+
+
+def test_sign_batch_other_coin(cmd, button, model, account):
+    _, sender = account
+
+    cmd.sign_batch(bip32_path=BIP32_PATH,
+                   tx_count=2,
+                   total_amount=200,
+                   max_gas_fee=20_000,
+                   button=button,
+                   model=model)
+
+    with pytest.raises(BatchMismatchError):
+        cmd.sign_batch_tx(data=transfer(sender, 10, 100, module=b"coin", coin=OTHER_COIN))
+
+
+def test_sign_batch_amount_over_total(cmd, button, model, account):
+    _, sender = account
+
+    cmd.sign_batch(bip32_path=BIP32_PATH,
+                   tx_count=2,
+                   total_amount=150,
+                   max_gas_fee=20_000,
+                   button=button,
+                   model=model)
+
+    cmd.sign_batch_tx(data=transfer(sender, 10, 100))
+    with pytest.raises(BatchMismatchError):
+        cmd.sign_batch_tx(data=transfer(sender, 11, 100))
+
+
+def test_sign_batch_other_chain(cmd, button, model, account):
+    _, sender = account
+
+    cmd.sign_batch(bip32_path=BIP32_PATH,
+                   tx_count=2,
+                   total_amount=200,
+                   max_gas_fee=20_000,
+                   button=button,
+                   model=model)
+
+    cmd.sign_batch_tx(data=transfer(sender, 10, 100, chain_id=2))
+    # transactions of a batch cannot target another chain than the first one
+    with pytest.raises(BatchMismatchError):
+        cmd.sign_batch_tx(data=transfer(sender, 11, 100, chain_id=1))
+
+
+@pytest.mark.parametrize("max_gas_amount, gas_unit_price", [
+    (201, 100),
+    # max_gas_amount * gas_unit_price overflows u64
+    (2**64 - 1, 2),
+])
+def test_sign_batch_gas_fee_over_max(cmd, button, model, account,
+                                     max_gas_amount, gas_unit_price):
+    _, sender = account
+
+    cmd.sign_batch(bip32_path=BIP32_PATH,
+                   tx_count=2,
+                   total_amount=200,
+                   max_gas_fee=20_000,
+                   button=button,
+                   model=model)
+
+    with pytest.raises(BatchMismatchError):
+        cmd.sign_batch_tx(data=transfer(sender, 10, 100,
+                                        max_gas_amount=max_gas_amount,
+                                        gas_unit_price=gas_unit_price))
+
+
+def test_sign_batch_reject(cmd, button, model, account):
+    _, sender = account
+
+    with pytest.raises(DenyError):
+        cmd.sign_batch(bip32_path=BIP32_PATH,
+                       tx_count=2,
+                       total_amount=200,
+                       max_gas_fee=20_000,
+                       button=button,
+                       model=model,
+                       approve=False)
+
+    # the private key is wiped, nothing can be signed
+    with pytest.raises(BadStateError):
+        cmd.sign_batch_tx(data=transfer(sender, 10, 100))
@@ -0,0 +1,62 @@
+import hashlib
+
+import pytest
+from nacl.signing import SigningKey
+
+from aptos_client.exception import *
+
+
+# test key trusted by `make ABI_TEST_KEY=1`, see tests/README.md
+ABI_TEST_SEED = hashlib.sha256(b"aptos ledger abi test key").digest()
+
+
+def name(value: str) -> bytes:
+    return len(value).to_bytes(1, byteorder="big") + value.encode("ascii")
+
+
+def descriptor(version: int = 1) -> bytes:
+    # 0x2a::vault::deposit(amount: u64 with 8 decimals, memo: String,
+    #                      locked: bool, beneficiary: address)
+    args = [("amount", 0x04, 8), ("memo", 0x08, 0), ("locked", 0x00, 0), ("beneficiary", 0x07, 0)]
+    body = bytes([version]) + bytes(31) + b"\x2a" + name("vault") + name("deposit")
+    body += len(args).to_bytes(1, byteorder="big")
+    for arg_name, arg_type, decimals in args:
+        body += name(arg_name) + bytes([arg_type, decimals])
+    return body
+
+
+def sign(body: bytes) -> bytes:
+    return SigningKey(ABI_TEST_SEED).sign(body).signature
+
+
+@pytest.fixture
+def abi_cmd(cmd):
+    try:
+        cmd.check_abi(digest=bytes(32))
+    except InsNotSupportedError:
+        pytest.skip("application built without ABI_TEST_KEY=1")
+    yield cmd
+
+
+def test_provide_abi(abi_cmd):
+    body = descriptor()
+    digest = hashlib.sha3_256(body).digest()
+
+    assert abi_cmd.provide_abi(descriptor=body, signature=sign(body)) == digest
+    assert abi_cmd.check_abi(digest=digest)
+
+
+def test_provide_abi_bad_signature(abi_cmd):
+    body = descriptor()
+    signature = bytearray(sign(body))
+    signature[0] ^= 1
+
+    with pytest.raises(AbiSignatureFailError):
+        abi_cmd.provide_abi(descriptor=body, signature=bytes(signature))
+
+
+def test_provide_abi_bad_descriptor(abi_cmd):
+    body = descriptor(version=2)
+
+    with pytest.raises(AbiDescriptorFailError):
+        abi_cmd.provide_abi(descriptor=body, signature=sign(body))
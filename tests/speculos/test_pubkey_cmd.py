@@ -1,3 +1,6 @@
+import hashlib
+
+
 def test_get_public_key(cmd):
     pub_key, chain_code = cmd.get_public_key(
         bip32_path="m/44'/637'/1'/0'/0'",
@@ -6,3 +9,43 @@ def test_get_public_key(cmd):
 
     assert len(pub_key) == 33
     assert len(chain_code) == 32
+
+
+def test_get_public_key_and_address(cmd):
+    pub_key, chain_code, address = cmd.get_public_key_and_address(
+        bip32_path="m/44'/637'/1'/0'/0'"
+    )  # type: bytes, bytes, bytes
+
+    assert len(pub_key) == 33
+    assert len(chain_code) == 32
+    assert address == hashlib.sha3_256(pub_key[1:] + b"\x00").digest()
+
+
+def test_get_public_keys(cmd):
+    pub_keys = cmd.get_public_keys(
+        bip32_path="m/44'/637'/0'/0'/0'",
+        index_position=2,
+        start=0,
+        count=7
+    )  # type: List[bytes]
+
+    assert len(pub_keys) == 7
+    assert len(set(pub_keys)) == 7
+
+    pub_key, _ = cmd.get_public_key(
+        bip32_path="m/44'/637'/1'/0'/0'",
+        display=False
+    )  # type: bytes, bytes
+
+    assert pub_key[1:] == pub_keys[1]
+
+    addresses = cmd.get_public_keys(
+        bip32_path="m/44'/637'/0'/0'/0'",
+        index_position=2,
+        start=1,
+        count=1,
+        addresses=True
+    )  # type: List[bytes]
+
+    assert len(addresses) == 1
+    assert len(addresses[0]) == 32
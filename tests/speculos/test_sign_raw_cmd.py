@@ -1,3 +1,5 @@
+import hashlib
+
 from nacl.signing import VerifyKey
 from nacl.exceptions import BadSignatureError
 
@@ -15,11 +17,13 @@ def test_sign_raw_tx(cmd, model):
 
     pk = VerifyKey(pub_key[1:])
 
-    der_sig = cmd.sign_raw(bip32_path=bip32_path,
-                           data=message,
-                           model=model)
+    der_sig, message_hash = cmd.sign_raw(bip32_path=bip32_path,
+                                         data=message,
+                                         model=model)
 
     try:
         pk.verify(signature=der_sig, smessage=message)
     except BadSignatureError as exc:
         assert False, exc
+
+    assert message_hash == hashlib.sha3_256(message).digest()
@@ -0,0 +1,299 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "abi/cache.h"
+#include "abi/descriptor.h"
+#include "transaction/deserialize.h"
+#include "transaction/fields.h"
+#include "transaction/types.h"
+
+// 0x2a::vault::deposit(amount: u64 with 8 decimals, memo: String,
+//                      locked: bool, beneficiary: address)
+// clang-format off
+static const uint8_t vault_deposit_abi[] = {
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x2a, 0x05, 0x76, 0x61, 0x75, 0x6c, 0x74, 0x07,
+    0x64, 0x65, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x04,
+    0x06, 0x61, 0x6d, 0x6f, 0x75, 0x6e, 0x74, 0x04,
+    0x08, 0x04, 0x6d, 0x65, 0x6d, 0x6f, 0x08, 0x00,
+    0x06, 0x6c, 0x6f, 0x63, 0x6b, 0x65, 0x64, 0x00,
+    0x00, 0x0b, 0x62, 0x65, 0x6e, 0x65, 0x66, 0x69,
+    0x63, 0x69, 0x61, 0x72, 0x79, 0x07, 0x00
+};
+
+static const uint8_t vault_deposit_tx[] = {
+    0xb5, 0xe9, 0x7d, 0xb0, 0x7f, 0xa0, 0xbd, 0x0e,
+    0x55, 0x98, 0xaa, 0x36, 0x43, 0xa9, 0xbc, 0x6f,
+    0x66, 0x93, 0xbd, 0xdc, 0x1a, 0x9f, 0xec, 0x9e,
+    0x67, 0x4a, 0x46, 0x1e, 0xaa, 0x00, 0xb1, 0x93,
+    0x78, 0x31, 0x35, 0xe8, 0xb0, 0x04, 0x30, 0x25,
+    0x3a, 0x22, 0xba, 0x04, 0x1d, 0x86, 0x0c, 0x37,
+    0x3d, 0x7a, 0x15, 0x01, 0xcc, 0xf7, 0xac, 0x2d,
+    0x1a, 0xd3, 0x7a, 0x8e, 0xd2, 0x77, 0x5a, 0xee,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x2a, 0x05, 0x76, 0x61, 0x75, 0x6c, 0x74, 0x07,
+    0x64, 0x65, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x00,
+    0x04, 0x08, 0x15, 0xcd, 0x5b, 0x07, 0x00, 0x00,
+    0x00, 0x00, 0x06, 0x05, 0x68, 0x65, 0x6c, 0x6c,
+    0x6f, 0x01, 0x01, 0x20, 0x09, 0x4c, 0x6f, 0xc0,
+    0xd3, 0xb3, 0x82, 0xa5, 0x99, 0xc3, 0x7e, 0x1a,
+    0xaa, 0x76, 0x18, 0xef, 0xf2, 0xc9, 0x6a, 0x35,
+    0x86, 0x87, 0x60, 0x82, 0xc4, 0x59, 0x4c, 0x50,
+    0xc5, 0x0d, 0x7d, 0xde, 0xd0, 0x07, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x56, 0x5c, 0x92, 0x63,
+    0x00, 0x00, 0x00, 0x00, 0x02
+};
+// clang-format on
+
+/**
+ * Descriptor body of 0x2a::vault::<function> with one argument per type.
+ */
+static size_t abi_body(uint8_t *body, const char *function, uint8_t args_size) {
+    size_t len = 0;
+
+    body[len++] = ABI_DESCRIPTOR_VERSION;
+    memset(body + len, 0, ADDRESS_LEN);
+    body[len + ADDRESS_LEN - 1] = 0x2a;
+    len += ADDRESS_LEN;
+    body[len++] = 5;
+    memcpy(body + len, "vault", 5);
+    len += 5;
+    body[len++] = strlen(function);
+    memcpy(body + len, function, strlen(function));
+    len += strlen(function);
+    body[len++] = args_size;
+    for (uint8_t i = 0; i < args_size; i++) {
+        body[len++] = 2;
+        body[len++] = 'a';
+        body[len++] = '0' + i;
+        body[len++] = i;  // abi_type_e
+        body[len++] = (i == ABI_TYPE_U64 || i == ABI_TYPE_U128) ? 2 : 0;
+    }
+
+    return len;
+}
+
+static void test_abi_descriptor_parse(void **state) {
+    (void) state;
+
+    abi_descriptor_t abi;
+    uint8_t body[ABI_DESCRIPTOR_MAX_LEN + 1] = {0};
+
+    assert_true(abi_descriptor_parse(vault_deposit_abi, sizeof(vault_deposit_abi), &abi));
+    assert_int_equal(abi.module_address[ADDRESS_LEN - 1], 0x2a);
+    assert_memory_equal(abi.module_name.bytes, "vault", abi.module_name.len);
+    assert_memory_equal(abi.function_name.bytes, "deposit", abi.function_name.len);
+    assert_int_equal(abi.args_size, 4);
+    assert_memory_equal(abi.args[0].name.bytes, "amount", abi.args[0].name.len);
+    assert_int_equal(abi.args[0].type, ABI_TYPE_U64);
+    assert_int_equal(abi.args[0].decimals, 8);
+    assert_memory_equal(abi.args[3].name.bytes, "beneficiary", abi.args[3].name.len);
+    assert_int_equal(abi.args[3].type, ABI_TYPE_ADDRESS);
+
+    size_t len = abi_body(body, "all", ABI_ARGS_MAX);
+    assert_true(abi_descriptor_parse(body, len, &abi));
+    // truncated or trailing bytes
+    assert_false(abi_descriptor_parse(body, len - 1, &abi));
+    assert_false(abi_descriptor_parse(body, len + 1, &abi));
+    // unknown version
+    body[0] = 2;
+    assert_false(abi_descriptor_parse(body, len, &abi));
+    body[0] = ABI_DESCRIPTOR_VERSION;
+    // function name is not an identifier
+    body[1 + ADDRESS_LEN + 6 + 1] = '-';
+    assert_false(abi_descriptor_parse(body, len, &abi));
+    body[1 + ADDRESS_LEN + 6 + 1] = '0';
+    assert_false(abi_descriptor_parse(body, len, &abi));
+    body[1 + ADDRESS_LEN + 6 + 1] = 'a';
+    // decimals of a bool, unknown type
+    const size_t first_arg = 1 + ADDRESS_LEN + 6 + 4 + 1;
+    body[first_arg + 4] = 1;
+    assert_false(abi_descriptor_parse(body, len, &abi));
+    body[first_arg + 4] = 0;
+    body[first_arg + 3] = ABI_TYPE_BYTES + 1;
+    assert_false(abi_descriptor_parse(body, len, &abi));
+    // too many arguments
+    len = abi_body(body, "all", ABI_ARGS_MAX + 1);
+    assert_false(abi_descriptor_parse(body, len, &abi));
+}
+
+static void test_abi_cache(void **state) {
+    (void) state;
+
+    static abi_cache_t cache;
+    abi_descriptor_t abi;
+    uint8_t body[ABI_DESCRIPTOR_MAX_LEN] = {0};
+    uint8_t digest[ABI_DIGEST_LEN] = {0};
+    char function[3] = "f0";
+
+    abi_cache_init(&cache);
+    assert_false(abi_cache_put(&cache, body, 10, digest));
+
+    for (uint8_t i = 0; i < ABI_CACHE_SIZE; i++) {
+        function[1] = '0' + i;
+        memset(digest, i, sizeof(digest));
+        assert_true(abi_cache_put(&cache, body, abi_body(body, function, 1), digest));
+    }
+    // f0 is used again, f1 is now the least recently used
+    memset(digest, 0, sizeof(digest));
+    assert_true(abi_cache_contains(&cache, digest));
+
+    function[1] = '0' + ABI_CACHE_SIZE;
+    memset(digest, ABI_CACHE_SIZE, sizeof(digest));
+    assert_true(abi_cache_put(&cache, body, abi_body(body, function, 1), digest));
+    for (uint8_t i = 0; i <= ABI_CACHE_SIZE; i++) {
+        memset(digest, i, sizeof(digest));
+        assert_int_equal(abi_cache_contains(&cache, digest), i != 1);
+    }
+
+    // a new version of f0 replaces it
+    memset(digest, 0xff, sizeof(digest));
+    assert_true(abi_cache_put(&cache, body, abi_body(body, "f0", 2), digest));
+    memset(digest, 0, sizeof(digest));
+    assert_false(abi_cache_contains(&cache, digest));
+    memset(digest, 2, sizeof(digest));
+    assert_true(abi_cache_contains(&cache, digest));
+
+    static transaction_t tx;
+    buffer_t buf = {.ptr = vault_deposit_tx, .size = sizeof(vault_deposit_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_false(abi_cache_find(&cache, &tx.payload.entry_function, &abi));
+    memset(digest, 0xee, sizeof(digest));
+    assert_true(abi_cache_put(&cache, vault_deposit_abi, sizeof(vault_deposit_abi), digest));
+    assert_true(abi_cache_find(&cache, &tx.payload.entry_function, &abi));
+    assert_int_equal(abi.args_size, 4);
+}
+
+static void test_abi_arg_format(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    abi_descriptor_t abi;
+    char value[TX_FIELD_ARG_LEN] = {0};
+
+    buffer_t buf = {.ptr = vault_deposit_tx, .size = sizeof(vault_deposit_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_true(abi_descriptor_parse(vault_deposit_abi, sizeof(vault_deposit_abi), &abi));
+
+    assert_true(transaction_abi_arg_format(&tx, &abi, 0, value, sizeof(value)));
+    assert_string_equal(value, "1.23456789");
+    assert_true(transaction_abi_arg_format(&tx, &abi, 1, value, sizeof(value)));
+    assert_string_equal(value, "hello");
+    assert_true(transaction_abi_arg_format(&tx, &abi, 2, value, sizeof(value)));
+    assert_string_equal(value, "true");
+    assert_true(transaction_abi_arg_format(&tx, &abi, 3, value, sizeof(value)));
+    assert_string_equal(value,
+                        "0x094C6FC0D3B382A599C37E1AAA7618EFF2C96A3586876082C4594C50C50D7DDE");
+    assert_false(transaction_abi_arg_format(&tx, &abi, 4, value, sizeof(value)));
+    assert_string_equal(value, "");
+
+    // value is never truncated
+    assert_false(transaction_abi_arg_format(&tx, &abi, 3, value, 66));
+    assert_true(transaction_abi_arg_format(&tx, &abi, 3, value, 67));
+
+    // amount described as a string, memo as a bool
+    abi.args[0].type = ABI_TYPE_STRING;
+    abi.args[1].type = ABI_TYPE_BOOL;
+    assert_false(transaction_abi_arg_format(&tx, &abi, 0, value, sizeof(value)));
+    assert_false(transaction_abi_arg_format(&tx, &abi, 1, value, sizeof(value)));
+}
+
+static void test_abi_arg_format_types(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    abi_descriptor_t abi;
+    uint8_t body[ABI_DESCRIPTOR_MAX_LEN] = {0};
+    char value[TX_FIELD_ARG_LEN] = {0};
+    // clang-format off
+    uint8_t bool_false[] = {0x00};
+    uint8_t u8[] = {0xff};
+    uint8_t u16[] = {0x34, 0x12};
+    uint8_t u32[] = {0x78, 0x56, 0x34, 0x12};
+    uint8_t u64[] = {0x39, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    uint8_t u128[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    uint8_t u256[32] = {0xcd};
+    uint8_t address[ADDRESS_LEN] = {0x01};
+    uint8_t string[] = {0x03, 'a', '\n', 'b'};
+    uint8_t bytes[1 + 124] = {0x01, 0x5a};
+    // clang-format on
+    fixed_bytes_t args[ABI_ARGS_MAX] = {
+        {bool_false, sizeof(bool_false)},
+        {u8, sizeof(u8)},
+        {u16, sizeof(u16)},
+        {u32, sizeof(u32)},
+        {u64, sizeof(u64)},
+        {u128, sizeof(u128)},
+        {u256, sizeof(u256)},
+        {address, sizeof(address)},
+    };
+    static const char *const expected[ABI_ARGS_MAX] = {
+        "false",
+        "255",
+        "4660",
+        "305419896",
+        "123.45",
+        "3402823669209384634633746074317682114.55",
+        "0xAB000000000000000000000000000000000000000000000000000000000000CD",
+        "0x0100000000000000000000000000000000000000000000000000000000000000",
+    };
+
+    u256[31] = 0xab;
+    tx.payload_variant = PAYLOAD_ENTRY_FUNCTION;
+    tx.payload.entry_function.known_type = FUNC_UNKNOWN;
+    tx.payload.entry_function.args.args_size = ABI_ARGS_MAX;
+    tx.payload.entry_function.args.raw.args = args;
+
+    // abi_body() gives argument i the type i, with 2 decimals for amounts
+    assert_true(abi_descriptor_parse(body, abi_body(body, "all", ABI_ARGS_MAX), &abi));
+    for (size_t i = 0; i < ABI_ARGS_MAX; i++) {
+        assert_true(transaction_abi_arg_format(&tx, &abi, i, value, sizeof(value)));
+        assert_string_equal(value, expected[i]);
+    }
+
+    // string which is not printable, bytes
+    abi.args[0].type = ABI_TYPE_STRING;
+    args[0] = (fixed_bytes_t){string, sizeof(string)};
+    abi.args[1].type = ABI_TYPE_BYTES;
+    args[1] = (fixed_bytes_t){bytes, 2};
+    assert_true(transaction_abi_arg_format(&tx, &abi, 0, value, sizeof(value)));
+    assert_string_equal(value, "0x610A62");
+    assert_true(transaction_abi_arg_format(&tx, &abi, 1, value, sizeof(value)));
+    assert_string_equal(value, "0x5A");
+
+    // 2 + 2 * 124 characters and the null terminator do not fit on screen
+    bytes[0] = 123;
+    args[1].len = 1 + 123;
+    assert_true(transaction_abi_arg_format(&tx, &abi, 1, value, sizeof(value)));
+    bytes[0] = 124;
+    args[1].len = 1 + 124;
+    assert_false(transaction_abi_arg_format(&tx, &abi, 1, value, sizeof(value)));
+
+    // arguments not kept by the parser
+    tx.payload.entry_function.args.raw.args = NULL;
+    assert_false(transaction_abi_arg_format(&tx, &abi, 7, value, sizeof(value)));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_abi_descriptor_parse),
+                                       cmocka_unit_test(test_abi_cache),
+                                       cmocka_unit_test(test_abi_arg_format),
+                                       cmocka_unit_test(test_abi_arg_format_types)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -8,6 +8,7 @@
 #include <cmocka.h>
 
 #include "types.h"
+#include "constants.h"
 #include "apdu/parser.h"
 
 static void test_apdu_parser(void **state) {
@@ -34,8 +35,55 @@ static void test_apdu_parser(void **state) {
     assert_memory_equal(cmd.data, ((uint8_t[]){0x00, 0x01, 0x02, 0x03, 0x04}), cmd.lc);
 }
 
+static void test_apdu_parser_extended(void **state) {
+    (void) state;
+    uint8_t apdu_bad_ext_len[] = {0xE0, 0x06, 0x01, 0x80, 0x00, 0x01};  // truncated extended Lc
+    uint8_t apdu_bad_ext_lc[] = {0xE0, 0x06, 0x01, 0x80, 0x00, 0x01, 0x00, 0xAA};
+    uint8_t apdu_empty[] = {0xE0, 0x03, 0x00, 0x00, 0x00};
+    static uint8_t apdu[7 + 300];
+    static uint8_t apdu_too_long[7 + MAX_EXT_LC + 1];
+
+    command_t cmd;
+
+    memset(&cmd, 0, sizeof(cmd));
+    assert_false(apdu_parser(&cmd, apdu_bad_ext_len, sizeof(apdu_bad_ext_len)));
+
+    memset(&cmd, 0, sizeof(cmd));
+    assert_false(apdu_parser(&cmd, apdu_bad_ext_lc, sizeof(apdu_bad_ext_lc)));
+
+    // Lc larger than the bytes received
+    memset(&cmd, 0, sizeof(cmd));
+    assert_false(apdu_parser(&cmd, apdu_bad_ext_lc, 7));
+
+    // command data larger than MAX_EXT_LC, even if received whole
+    memcpy(apdu_too_long, ((uint8_t[]){0xE0, 0x06, 0x01, 0x80, 0x00, 0x04, 0x01}), 7);
+    memset(&cmd, 0, sizeof(cmd));
+    assert_false(apdu_parser(&cmd, apdu_too_long, sizeof(apdu_too_long)));
+
+    // short APDU without command data is not mistaken for an extended one
+    memset(&cmd, 0, sizeof(cmd));
+    assert_true(apdu_parser(&cmd, apdu_empty, sizeof(apdu_empty)));
+    assert_int_equal(cmd.lc, 0);
+    assert_null(cmd.data);
+
+    memcpy(apdu, ((uint8_t[]){0xE0, 0x06, 0x01, 0x80, 0x00, 0x01, 0x2C}), 7);
+    for (size_t i = 0; i < 300; i++) {
+        apdu[7 + i] = (uint8_t) i;
+    }
+
+    memset(&cmd, 0, sizeof(cmd));
+    assert_true(apdu_parser(&cmd, apdu, sizeof(apdu)));
+    assert_int_equal(cmd.cla, 0xE0);
+    assert_int_equal(cmd.ins, 0x06);
+    assert_int_equal(cmd.p1, 0x01);
+    assert_int_equal(cmd.p2, 0x80);
+    assert_int_equal(cmd.lc, 300);
+    assert_ptr_equal(cmd.data, apdu + 7);
+}
+
 int main() {
-    const struct CMUnitTest tests[] = {cmocka_unit_test(test_apdu_parser)};
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_apdu_parser),
+                                       cmocka_unit_test(test_apdu_parser_extended)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -0,0 +1,67 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "common/ascii.h"
+
+static size_t ascii_prefix_len_bytewise(const uint8_t *in, size_t in_len) {
+    size_t i = 0;
+
+    while (i < in_len && in[i] < 0x80) {
+        i++;
+    }
+
+    return i;
+}
+
+static void test_ascii_prefix_len(void **state) {
+    (void) state;
+
+    const uint8_t hello[] = {0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x21};  // Hello!
+    const uint8_t times[] = {0x32, 0xc3, 0x97, 0x32, 0x3d, 0x34};  // 2×2=4
+
+    assert_int_equal(ascii_prefix_len(hello, sizeof(hello)), sizeof(hello));
+    assert_int_equal(ascii_prefix_len(times, sizeof(times)), 1);
+    assert_int_equal(ascii_prefix_len(times, 1), 1);
+    assert_int_equal(ascii_prefix_len(hello, 0), 0);
+}
+
+static void test_ascii_prefix_len_positions(void **state) {
+    (void) state;
+
+    // every alignment, length and position of the first non-ASCII byte
+    // around word and vector boundaries
+    uint8_t buf[8 + 96];
+
+    for (size_t align = 0; align < 8; align++) {
+        for (size_t len = 0; len <= 96; len++) {
+            uint8_t *in = buf + align;
+
+            memset(buf, 'a', sizeof(buf));
+            assert_int_equal(ascii_prefix_len(in, len), len);
+
+            for (size_t pos = 0; pos < len; pos++) {
+                memset(buf, 'a', sizeof(buf));
+                in[pos] = (pos % 2) ? 0x80 : 0xFF;
+                // non-ASCII bytes after the first one don't matter
+                if (pos + 3 < len) {
+                    in[pos + 3] = 0xC3;
+                }
+                assert_int_equal(ascii_prefix_len(in, len), pos);
+                assert_int_equal(ascii_prefix_len(in, len), ascii_prefix_len_bytewise(in, len));
+            }
+        }
+    }
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_ascii_prefix_len),
+                                       cmocka_unit_test(test_ascii_prefix_len_positions)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -58,12 +58,146 @@ static void test_string(void **state) {
     assert_string_equal(str, "0x1::coin::transfer");
 }
 
+static void test_utf8_to_ascii(void **state) {
+    (void) state;
+
+    // "Connexion à la place de marché — ok" with 2- and 3-byte sequences
+    const uint8_t utf8[] = "Connexion \xc3\xa0 la place de march\xc3\xa9 \xe2\x80\x94 ok";
+    const uint8_t ascii[] = "Sign in to the marketplace, nonce 1667597331";
+    const uint8_t invalid[] = "Sign in \xc3 to";
+    uint8_t out[64] = {0};
+    bool is_utf8 = true;
+
+    assert_int_equal(try_utf8_to_ascii(ascii, sizeof(ascii) - 1, out, sizeof(out), &is_utf8),
+                     sizeof(ascii) - 1);
+    assert_memory_equal(out, ascii, sizeof(ascii) - 1);
+    assert_false(is_utf8);
+
+    assert_int_equal(try_utf8_to_ascii(utf8, sizeof(utf8) - 1, out, sizeof(out), &is_utf8), 35);
+    assert_memory_equal(out, "Connexion ? la place de march? ? ok", 35);
+    assert_true(is_utf8);
+
+    assert_int_equal(try_utf8_to_ascii(invalid, sizeof(invalid) - 1, out, sizeof(out), NULL), -1);
+
+    // output too short, filled up to its end
+    memset(out, 0, sizeof(out));
+    assert_int_equal(try_utf8_to_ascii(ascii, sizeof(ascii) - 1, out, 10, NULL), -2);
+    assert_memory_equal(out, ascii, 10);
+    assert_int_equal(out[10], 0);
+    assert_int_equal(try_utf8_to_ascii(utf8, sizeof(utf8) - 1, out, 11, NULL), -2);
+    assert_memory_equal(out, "Connexion ?", 11);
+}
+
+static size_t put_struct_tag(uint8_t *out,
+                             uint8_t address,
+                             const char *module,
+                             const char *name,
+                             uint8_t type_args_size) {
+    size_t offset = 0;
+
+    out[offset++] = TYPE_TAG_STRUCT;
+    memset(out + offset, 0, ADDRESS_LEN);
+    out[offset + ADDRESS_LEN - 1] = address;
+    offset += ADDRESS_LEN;
+    out[offset++] = strlen(module);
+    memcpy(out + offset, module, strlen(module));
+    offset += strlen(module);
+    out[offset++] = strlen(name);
+    memcpy(out + offset, name, strlen(name));
+    offset += strlen(name);
+    out[offset++] = type_args_size;
+
+    return offset;
+}
+
+static void test_type_tag(void **state) {
+    (void) state;
+
+    static bcs_arena_t arena;
+    uint8_t raw[256];
+    size_t len = 0;
+    type_tag_t ty;
+
+    // 0x1::coin::Coin<0xab::lp::LP<0x2::x::X, 0x3::y::Y>>
+    len += put_struct_tag(raw + len, 0x01, "coin", "Coin", 1);
+    len += put_struct_tag(raw + len, 0xab, "lp", "LP", 2);
+    len += put_struct_tag(raw + len, 0x02, "x", "X", 0);
+    len += put_struct_tag(raw + len, 0x03, "y", "Y", 0);
+
+    bcs_arena_reset(&arena);
+    buffer_t buf = {.ptr = raw, .size = len, .offset = 0};
+    assert_true(bcs_read_type_tag(&buf, &arena, &ty));
+    assert_int_equal(buf.offset, len);
+    assert_int_equal(ty.type_tag, TYPE_TAG_STRUCT);
+    type_tag_struct_t *coin = ty.value;
+    assert_int_equal(coin->address[ADDRESS_LEN - 1], 0x01);
+    assert_int_equal(coin->name.len, 4);
+    assert_memory_equal(coin->name.bytes, "Coin", 4);
+    assert_int_equal(coin->type_args_size, 1);
+    assert_int_equal(coin->type_args[0].type_tag, TYPE_TAG_STRUCT);
+    type_tag_struct_t *lp = coin->type_args[0].value;
+    assert_memory_equal(lp->module_name.bytes, "lp", 2);
+    assert_int_equal(lp->type_args_size, 2);
+    assert_memory_equal(((type_tag_struct_t *) lp->type_args[0].value)->name.bytes, "X", 1);
+    assert_memory_equal(((type_tag_struct_t *) lp->type_args[1].value)->name.bytes, "Y", 1);
+
+    // vector<vector<u8>>
+    const uint8_t vector_raw[] = {TYPE_TAG_VECTOR, TYPE_TAG_VECTOR, TYPE_TAG_U8};
+    bcs_arena_reset(&arena);
+    buf = (buffer_t){.ptr = vector_raw, .size = sizeof(vector_raw), .offset = 0};
+    assert_true(bcs_read_type_tag(&buf, &arena, &ty));
+    assert_int_equal(ty.type_tag, TYPE_TAG_VECTOR);
+    assert_int_equal(((type_tag_t *) ty.value)->type_tag, TYPE_TAG_VECTOR);
+    assert_int_equal(((type_tag_t *) ((type_tag_t *) ty.value)->value)->type_tag, TYPE_TAG_U8);
+    assert_int_equal(arena.used, 2 * ((sizeof(type_tag_t) + 7) & ~(size_t) 7));
+
+    // nesting deeper than MAX_TYPE_TAG_NESTING is rejected
+    uint8_t deep_raw[MAX_TYPE_TAG_NESTING + 2];
+    memset(deep_raw, TYPE_TAG_VECTOR, sizeof(deep_raw));
+    deep_raw[sizeof(deep_raw) - 1] = TYPE_TAG_U8;
+    bcs_arena_reset(&arena);
+    buf = (buffer_t){.ptr = deep_raw, .size = sizeof(deep_raw), .offset = 0};
+    assert_false(bcs_read_type_tag(&buf, &arena, &ty));
+    buf = (buffer_t){.ptr = deep_raw + 1, .size = sizeof(deep_raw) - 1, .offset = 0};
+    assert_true(bcs_read_type_tag(&buf, &arena, &ty));
+
+    // truncated and unknown type tags
+    bcs_arena_reset(&arena);
+    buf = (buffer_t){.ptr = raw, .size = len - 1, .offset = 0};
+    assert_false(bcs_read_type_tag(&buf, &arena, &ty));
+    const uint8_t unknown_raw[] = {0x0b};
+    buf = (buffer_t){.ptr = unknown_raw, .size = sizeof(unknown_raw), .offset = 0};
+    assert_false(bcs_read_type_tag(&buf, &arena, &ty));
+}
+
+static void test_arena(void **state) {
+    (void) state;
+
+    static bcs_arena_t arena;
+
+    bcs_arena_reset(&arena);
+    uint8_t *first = bcs_arena_alloc(&arena, 1);
+    uint8_t *second = bcs_arena_alloc(&arena, 1);
+    assert_non_null(first);
+    assert_true(second == first + 8);
+    assert_null(bcs_arena_alloc(&arena, TYPE_TAG_ARENA_SIZE));
+    assert_non_null(bcs_arena_alloc(&arena, TYPE_TAG_ARENA_SIZE - 16));
+    assert_null(bcs_arena_alloc(&arena, 1));
+
+    bcs_arena_reset(&arena);
+    assert_int_equal(arena.used, 0);
+    assert_true(bcs_arena_alloc(&arena, TYPE_TAG_ARENA_SIZE) == first);
+}
+
 int main() {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_u8),
         cmocka_unit_test(test_u32_from_uleb128),
         cmocka_unit_test(test_dynamic_bytes),
         cmocka_unit_test(test_string),
+        cmocka_unit_test(test_utf8_to_ascii),
+        cmocka_unit_test(test_type_tag),
+        cmocka_unit_test(test_arena),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
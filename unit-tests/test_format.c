@@ -82,6 +82,52 @@ static void test_format_fpu64(void **state) {
     assert_false(format_fpu64(temp2, sizeof(temp2) - 20, amount, 18));
 }
 
+static void test_format_u128(void **state) {
+    (void) state;
+
+    char temp[40] = {0};
+
+    uint128_t value = {.high = 0, .low = 0};
+    assert_true(format_u128(temp, sizeof(temp), &value));
+    assert_string_equal(temp, "0");
+
+    value.low = 1000000000ull;
+    assert_true(format_u128(temp, sizeof(temp), &value));
+    assert_string_equal(temp, "1000000000");
+
+    value = (uint128_t){.high = 1, .low = 0};  // 2^64
+    assert_true(format_u128(temp, sizeof(temp), &value));
+    assert_string_equal(temp, "18446744073709551616");
+
+    value = (uint128_t){.high = UINT64_MAX, .low = UINT64_MAX};  // MAX_UINT128
+    assert_true(format_u128(temp, sizeof(temp), &value));
+    assert_string_equal(temp, "340282366920938463463374607431768211455");
+
+    // buffer too small
+    assert_false(format_u128(temp, sizeof(temp) - 1, &value));
+}
+
+static void test_format_fpu128(void **state) {
+    (void) state;
+
+    char temp[60] = {0};
+
+    uint128_t amount = {.high = 0, .low = 100ull};  // octa
+    assert_true(format_fpu128(temp, sizeof(temp), &amount, 8));
+    assert_string_equal(temp, "0.00000100");  // APT
+
+    amount = (uint128_t){.high = 0x10, .low = 0};  // 2^68 octa
+    assert_true(format_fpu128(temp, sizeof(temp), &amount, 8));
+    assert_string_equal(temp, "2951479051793.52825856");  // APT
+
+    amount = (uint128_t){.high = UINT64_MAX, .low = UINT64_MAX};
+    assert_true(format_fpu128(temp, sizeof(temp), &amount, 18));
+    assert_string_equal(temp, "340282366920938463463.374607431768211455");
+
+    // buffer too small
+    assert_false(format_fpu128(temp, sizeof(temp) - 20, &amount, 18));
+}
+
 static void test_format_hex(void **state) {
     (void) state;
 
@@ -99,6 +145,8 @@ int main() {
     const struct CMUnitTest tests[] = {cmocka_unit_test(test_format_i64),
                                        cmocka_unit_test(test_format_u64),
                                        cmocka_unit_test(test_format_fpu64),
+                                       cmocka_unit_test(test_format_u128),
+                                       cmocka_unit_test(test_format_fpu128),
                                        cmocka_unit_test(test_format_hex)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
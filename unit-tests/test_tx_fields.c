@@ -0,0 +1,290 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "transaction/deserialize.h"
+#include "transaction/fields.h"
+#include "transaction/types.h"
+#include "bcs/init.h"
+
+// clang-format off
+static const uint8_t coin_transfer_tx[] = {
+    0xb5, 0xe9, 0x7d, 0xb0, 0x7f, 0xa0, 0xbd, 0x0e,
+    0x55, 0x98, 0xaa, 0x36, 0x43, 0xa9, 0xbc, 0x6f,
+    0x66, 0x93, 0xbd, 0xdc, 0x1a, 0x9f, 0xec, 0x9e,
+    0x67, 0x4a, 0x46, 0x1e, 0xaa, 0x00, 0xb1, 0x93,
+    0x86, 0xbf, 0x1b, 0x58, 0x94, 0x2d, 0x9b, 0xf1,
+    0x24, 0x75, 0xa4, 0x1f, 0x2f, 0x43, 0xb9, 0x70,
+    0x87, 0xdd, 0x91, 0x93, 0x7f, 0x40, 0x1e, 0xec,
+    0x08, 0x31, 0x11, 0x68, 0xa9, 0xba, 0xc2, 0xf3,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x04, 0x63, 0x6f, 0x69, 0x6e, 0x08, 0x74,
+    0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x01,
+    0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x0a, 0x61, 0x70, 0x74, 0x6f, 0x73, 0x5f,
+    0x63, 0x6f, 0x69, 0x6e, 0x09, 0x41, 0x70, 0x74,
+    0x6f, 0x73, 0x43, 0x6f, 0x69, 0x6e, 0x00, 0x02,
+    0x20, 0xa7, 0x67, 0x6a, 0x00, 0x3b, 0x6f, 0xb4,
+    0x74, 0x48, 0xb7, 0x9b, 0x8d, 0x68, 0xd2, 0x88,
+    0x46, 0xb9, 0x29, 0x32, 0x94, 0x1c, 0x92, 0xbe,
+    0xec, 0xd1, 0x9f, 0x1b, 0xee, 0x6a, 0x68, 0x52,
+    0x08, 0x08, 0xcd, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x13, 0x84, 0x65, 0x63, 0x00, 0x00,
+    0x00, 0x00, 0x24
+};
+// clang-format on
+
+static void test_coin_transfer_fields(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    tx_field_e fields[TX_FIELDS_MAX];
+    char value[TX_FIELD_STRUCT_LEN] = {0};
+
+    buffer_t buf = {.ptr = coin_transfer_tx, .size = sizeof(coin_transfer_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+
+    assert_int_equal(transaction_fields_list(&tx, fields), 6);
+    assert_int_equal(fields[0], TX_FIELD_FUNCTION);
+    assert_int_equal(fields[1], TX_FIELD_COIN_TYPE);
+    assert_int_equal(fields[2], TX_FIELD_RECEIVER);
+    assert_int_equal(fields[3], TX_FIELD_AMOUNT);
+    assert_int_equal(fields[4], TX_FIELD_GAS_FEE);
+    assert_int_equal(fields[5], TX_FIELD_MESSAGE_HASH);
+
+    assert_true(transaction_field_format(&tx, TX_FIELD_FUNCTION, NULL, value, sizeof(value)));
+    assert_string_equal(value, "0x01::coin::transfer");
+    assert_true(transaction_field_format(&tx, TX_FIELD_COIN_TYPE, NULL, value, sizeof(value)));
+    assert_string_equal(value, "0x00..01::aptos_coin::AptosCoin");
+    assert_true(transaction_field_format(&tx, TX_FIELD_RECEIVER, NULL, value, sizeof(value)));
+    assert_string_equal(value,
+                        "0xA7676A003B6FB47448B79B8D68D28846B92932941C92BEECD19F1BEE6A685208");
+    // coin may not be APT, no unit
+    assert_true(transaction_field_format(&tx, TX_FIELD_AMOUNT, NULL, value, sizeof(value)));
+    assert_string_equal(value, "0.00000717");
+    assert_true(transaction_field_format(&tx, TX_FIELD_GAS_FEE, NULL, value, sizeof(value)));
+    assert_string_equal(value, "APT 0.02000000");
+
+    // exact beyond 64 bits
+    tx.max_gas_amount = UINT64_MAX;
+    tx.gas_unit_price = 100;
+    assert_true(transaction_field_format(&tx, TX_FIELD_GAS_FEE, NULL, value, sizeof(value)));
+    assert_string_equal(value, "APT 18446744073709.55161500");
+    tx.gas_unit_price = UINT64_MAX;
+    assert_true(transaction_field_format(&tx, TX_FIELD_GAS_FEE, NULL, value, sizeof(value)));
+    assert_string_equal(value, "APT 3402823669209384634264811192843.49108225");
+
+    // truncated like snprintf() on the device
+    assert_true(transaction_field_format(&tx, TX_FIELD_FUNCTION, NULL, value, 10));
+    assert_string_equal(value, "0x01::coi");
+    assert_false(transaction_field_format(&tx, TX_FIELD_POOL_ADDRESS + 100, NULL, value, 10));
+    assert_false(transaction_field_format(&tx, TX_FIELD_FUNCTION, NULL, value, 0));
+
+    assert_string_equal(transaction_field_title(TX_FIELD_COIN_TYPE), "Coin Type");
+    assert_int_equal(transaction_field_len(TX_FIELD_RECEIVER), 67);
+}
+
+static void test_with_data_fields(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    tx_field_e fields[TX_FIELDS_MAX];
+    char value[TX_FIELD_STRUCT_LEN] = {0};
+    uint8_t signers[3 * ADDRESS_LEN] = {0};
+    uint8_t fee_payer[ADDRESS_LEN] = {0};
+    uint8_t pool[ADDRESS_LEN] = {0};
+    uint8_t module[ADDRESS_LEN] = {0};
+    uint8_t module_name[] = "delegation_pool";
+    uint8_t function_name[] = "add_stake";
+
+    signers[ADDRESS_LEN - 1] = 0xa1;
+    signers[2 * ADDRESS_LEN - 1] = 0xa2;
+    fee_payer[ADDRESS_LEN - 1] = 0xfe;
+    pool[0] = 0x70;
+    module[ADDRESS_LEN - 1] = 0x01;
+
+    transaction_init(&tx);
+    tx.tx_variant = TX_RAW_WITH_DATA;
+    tx.with_data_variant = TX_WITH_DATA_FEE_PAYER;
+    tx.secondary_signers = signers;
+    tx.secondary_signers_size = 2;
+    tx.fee_payer = fee_payer;
+    tx.payload_variant = PAYLOAD_ENTRY_FUNCTION;
+    entry_function_payload_init(&tx.payload.entry_function);
+    tx.payload.entry_function.module_id.address = module;
+    tx.payload.entry_function.module_id.name.bytes = module_name;
+    tx.payload.entry_function.module_id.name.len = sizeof(module_name) - 1;
+    tx.payload.entry_function.function_name.bytes = function_name;
+    tx.payload.entry_function.function_name.len = sizeof(function_name) - 1;
+    tx.payload.entry_function.known_type = FUNC_DELEGATION_POOL_ADD_STAKE;
+    tx.payload.entry_function.args.delegation_pool.pool_address = pool;
+    tx.payload.entry_function.args.delegation_pool.amount = 1100000000;
+
+    assert_int_equal(transaction_fields_list(&tx, fields), 8);
+    assert_int_equal(fields[0], TX_FIELD_WITH_DATA_TYPE);
+    assert_int_equal(fields[1], TX_FIELD_FEE_PAYER);
+    assert_int_equal(fields[2], TX_FIELD_SECONDARY_SIGNERS);
+    assert_int_equal(fields[3], TX_FIELD_FUNCTION);
+    assert_int_equal(fields[4], TX_FIELD_POOL_ADDRESS);
+    assert_int_equal(fields[5], TX_FIELD_AMOUNT);
+    assert_int_equal(fields[6], TX_FIELD_GAS_FEE);
+    assert_int_equal(fields[7], TX_FIELD_MESSAGE_HASH);
+
+    assert_true(
+        transaction_field_format(&tx, TX_FIELD_WITH_DATA_TYPE, NULL, value, sizeof(value)));
+    assert_string_equal(value, "Fee payer");
+    assert_true(transaction_field_format(&tx, TX_FIELD_FEE_PAYER, NULL, value, sizeof(value)));
+    assert_string_equal(value,
+                        "0x00000000000000000000000000000000000000000000000000000000000000FE");
+    assert_true(
+        transaction_field_format(&tx, TX_FIELD_SECONDARY_SIGNERS, NULL, value, sizeof(value)));
+    assert_string_equal(value,
+                        "0x00000000000000000000000000000000000000000000000000000000000000A1 "
+                        "0x00000000000000000000000000000000000000000000000000000000000000A2");
+    assert_true(transaction_field_format(&tx, TX_FIELD_FUNCTION, NULL, value, sizeof(value)));
+    assert_string_equal(value, "0x01::delegation_pool::add_stake");
+    assert_true(transaction_field_format(&tx, TX_FIELD_AMOUNT, NULL, value, sizeof(value)));
+    assert_string_equal(value, "APT 11.00000000");
+
+    tx.secondary_signers_size = 3;
+    assert_true(
+        transaction_field_format(&tx, TX_FIELD_SECONDARY_SIGNERS, NULL, value, sizeof(value)));
+    assert_non_null(strstr(value, "A2 (+1 more)"));
+
+    tx.secondary_signers_size = 0;
+    tx.with_data_variant = TX_WITH_DATA_MULTI_AGENT;
+    tx.fee_payer = NULL;
+    assert_int_equal(transaction_fields_list(&tx, fields), 7);
+    assert_int_equal(fields[1], TX_FIELD_SECONDARY_SIGNERS);
+    assert_true(
+        transaction_field_format(&tx, TX_FIELD_SECONDARY_SIGNERS, NULL, value, sizeof(value)));
+    assert_string_equal(value, "None");
+    assert_true(
+        transaction_field_format(&tx, TX_FIELD_WITH_DATA_TYPE, NULL, value, sizeof(value)));
+    assert_string_equal(value, "Multi-agent");
+    assert_false(transaction_field_format(&tx, TX_FIELD_FEE_PAYER, NULL, value, sizeof(value)));
+}
+
+static void test_script_fields(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    tx_field_e fields[TX_FIELDS_MAX];
+    char value[TX_FIELD_STRUCT_LEN] = {0};
+    uint8_t script_hash[32] = {0};
+    uint8_t message_hash[32] = {0};
+
+    script_hash[0] = 0xab;
+    for (size_t i = 0; i < sizeof(message_hash); i++) {
+        message_hash[i] = (uint8_t) (0x10 + i);
+    }
+
+    transaction_init(&tx);
+    tx.tx_variant = TX_RAW;
+    tx.payload_variant = PAYLOAD_SCRIPT;
+    script_payload_init(&tx.payload.script);
+    tx.payload.script.ty_size = 1;
+    tx.payload.script.args_size = 2;
+
+    assert_int_equal(transaction_fields_list(&tx, fields), 4);
+    assert_int_equal(fields[0], TX_FIELD_TX_TYPE);
+    assert_int_equal(fields[1], TX_FIELD_SCRIPT_HASH);
+    assert_int_equal(fields[2], TX_FIELD_GAS_FEE);
+    assert_int_equal(fields[3], TX_FIELD_MESSAGE_HASH);
+
+    assert_true(transaction_field_format(&tx, TX_FIELD_TX_TYPE, NULL, value, sizeof(value)));
+    assert_string_equal(value, "Script [1 type args, 2 args]");
+    assert_false(transaction_field_format(&tx, TX_FIELD_SCRIPT_HASH, NULL, value, sizeof(value)));
+    assert_true(
+        transaction_field_format(&tx, TX_FIELD_SCRIPT_HASH, script_hash, value, sizeof(value)));
+    assert_string_equal(value,
+                        "0xAB00000000000000000000000000000000000000000000000000000000000000");
+
+    // only a fingerprint of the message hash fits on one screen
+    assert_false(transaction_field_format(&tx, TX_FIELD_MESSAGE_HASH, NULL, value, sizeof(value)));
+    assert_true(transaction_field_format(&tx, TX_FIELD_MESSAGE_HASH, message_hash, value, sizeof(value)));
+    assert_string_equal(value, "0x10111213...2C2D2E2F");
+    assert_string_equal(transaction_field_title(TX_FIELD_MESSAGE_HASH), "Message Hash");
+    assert_int_equal(transaction_field_len(TX_FIELD_MESSAGE_HASH), strlen(value) + 1);
+
+    tx.payload_variant = PAYLOAD_UNDEFINED;
+    assert_int_equal(transaction_fields_list(&tx, fields), 3);
+    assert_true(transaction_field_format(&tx, TX_FIELD_TX_TYPE, NULL, value, sizeof(value)));
+    assert_string_equal(value, "APTOS::RawTransaction [payload = UNKNOWN]");
+}
+
+/**
+ * Build coin_transfer_tx with the AptosCoin type args replaced by n struct args
+ * 0x1::aptos_coin::AptosCoin, following a u64 arg.
+ */
+static size_t generic_coin_transfer_tx(uint8_t *out, size_t n) {
+    // offset of the type args size of the coin struct
+    const size_t type_args_offset = 174;
+    static const uint8_t aptos_coin[] = {0x0a, 'a', 'p', 't', 'o', 's', '_', 'c', 'o', 'i', 'n',
+                                         0x09, 'A', 'p', 't', 'o', 's', 'C', 'o', 'i', 'n', 0x00};
+    size_t len = type_args_offset;
+
+    memcpy(out, coin_transfer_tx, type_args_offset);
+    out[len++] = (uint8_t) (n + 1);
+    out[len++] = TYPE_TAG_U64;
+    for (size_t i = 0; i < n; i++) {
+        out[len++] = TYPE_TAG_STRUCT;
+        memset(out + len, 0, 32);
+        out[len + 31] = 0x01;
+        len += 32;
+        memcpy(out + len, aptos_coin, sizeof(aptos_coin));
+        len += sizeof(aptos_coin);
+    }
+    memcpy(out + len,
+           coin_transfer_tx + type_args_offset + 1,
+           sizeof(coin_transfer_tx) - type_args_offset - 1);
+    return len + sizeof(coin_transfer_tx) - type_args_offset - 1;
+}
+
+static void test_generic_coin_type_fields(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    uint8_t raw_tx[1024];
+    char value[TX_FIELD_STRUCT_LEN] = {0};
+
+    size_t len = generic_coin_transfer_tx(raw_tx, 1);
+    buffer_t buf = {.ptr = raw_tx, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.payload.entry_function.args.coin_transfer.ty_coin.type_args_size, 2);
+    assert_int_equal(tx.payload.entry_function.args.coin_transfer.amount, 717);
+
+    assert_true(transaction_field_format(&tx, TX_FIELD_COIN_TYPE, NULL, value, sizeof(value)));
+    assert_string_equal(value,
+                        "0x00..01::aptos_coin::AptosCoin"
+                        "<u64, 0x00..01::aptos_coin::AptosCoin>");
+
+    // a coin type cut on screen is refused rather than shown truncated
+    len = generic_coin_transfer_tx(raw_tx, 8);
+    buf = (buffer_t){.ptr = raw_tx, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_false(transaction_field_format(&tx, TX_FIELD_COIN_TYPE, NULL, value, sizeof(value)));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_coin_transfer_fields),
+                                       cmocka_unit_test(test_generic_coin_type_fields),
+                                       cmocka_unit_test(test_with_data_fields),
+                                       cmocka_unit_test(test_script_fields)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -10,46 +10,48 @@
 #include "transaction/deserialize.h"
 #include "transaction/types.h"
 
+// clang-format off
+static const uint8_t coin_transfer_tx[] = {
+    0xb5, 0xe9, 0x7d, 0xb0, 0x7f, 0xa0, 0xbd, 0x0e,
+    0x55, 0x98, 0xaa, 0x36, 0x43, 0xa9, 0xbc, 0x6f,
+    0x66, 0x93, 0xbd, 0xdc, 0x1a, 0x9f, 0xec, 0x9e,
+    0x67, 0x4a, 0x46, 0x1e, 0xaa, 0x00, 0xb1, 0x93,
+    0x86, 0xbf, 0x1b, 0x58, 0x94, 0x2d, 0x9b, 0xf1,
+    0x24, 0x75, 0xa4, 0x1f, 0x2f, 0x43, 0xb9, 0x70,
+    0x87, 0xdd, 0x91, 0x93, 0x7f, 0x40, 0x1e, 0xec,
+    0x08, 0x31, 0x11, 0x68, 0xa9, 0xba, 0xc2, 0xf3,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x04, 0x63, 0x6f, 0x69, 0x6e, 0x08, 0x74,
+    0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x01,
+    0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x0a, 0x61, 0x70, 0x74, 0x6f, 0x73, 0x5f,
+    0x63, 0x6f, 0x69, 0x6e, 0x09, 0x41, 0x70, 0x74,
+    0x6f, 0x73, 0x43, 0x6f, 0x69, 0x6e, 0x00, 0x02,
+    0x20, 0xa7, 0x67, 0x6a, 0x00, 0x3b, 0x6f, 0xb4,
+    0x74, 0x48, 0xb7, 0x9b, 0x8d, 0x68, 0xd2, 0x88,
+    0x46, 0xb9, 0x29, 0x32, 0x94, 0x1c, 0x92, 0xbe,
+    0xec, 0xd1, 0x9f, 0x1b, 0xee, 0x6a, 0x68, 0x52,
+    0x08, 0x08, 0xcd, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x13, 0x84, 0x65, 0x63, 0x00, 0x00,
+    0x00, 0x00, 0x24
+};
+// clang-format on
+
 static void test_tx_deserialization(void **state) {
     (void) state;
 
     static transaction_t tx;
-    // clang-format off
-    static const uint8_t raw_tx[] = {
-        0xb5, 0xe9, 0x7d, 0xb0, 0x7f, 0xa0, 0xbd, 0x0e,
-        0x55, 0x98, 0xaa, 0x36, 0x43, 0xa9, 0xbc, 0x6f,
-        0x66, 0x93, 0xbd, 0xdc, 0x1a, 0x9f, 0xec, 0x9e,
-        0x67, 0x4a, 0x46, 0x1e, 0xaa, 0x00, 0xb1, 0x93,
-        0x86, 0xbf, 0x1b, 0x58, 0x94, 0x2d, 0x9b, 0xf1,
-        0x24, 0x75, 0xa4, 0x1f, 0x2f, 0x43, 0xb9, 0x70,
-        0x87, 0xdd, 0x91, 0x93, 0x7f, 0x40, 0x1e, 0xec,
-        0x08, 0x31, 0x11, 0x68, 0xa9, 0xba, 0xc2, 0xf3,
-        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x01, 0x04, 0x63, 0x6f, 0x69, 0x6e, 0x08, 0x74,
-        0x72, 0x61, 0x6e, 0x73, 0x66, 0x65, 0x72, 0x01,
-        0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x01, 0x0a, 0x61, 0x70, 0x74, 0x6f, 0x73, 0x5f,
-        0x63, 0x6f, 0x69, 0x6e, 0x09, 0x41, 0x70, 0x74,
-        0x6f, 0x73, 0x43, 0x6f, 0x69, 0x6e, 0x00, 0x02,
-        0x20, 0xa7, 0x67, 0x6a, 0x00, 0x3b, 0x6f, 0xb4,
-        0x74, 0x48, 0xb7, 0x9b, 0x8d, 0x68, 0xd2, 0x88,
-        0x46, 0xb9, 0x29, 0x32, 0x94, 0x1c, 0x92, 0xbe,
-        0xec, 0xd1, 0x9f, 0x1b, 0xee, 0x6a, 0x68, 0x52,
-        0x08, 0x08, 0xcd, 0x02, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x13, 0x84, 0x65, 0x63, 0x00, 0x00,
-        0x00, 0x00, 0x24
-    };
 
-    buffer_t buf = {.ptr = raw_tx, .size = sizeof(raw_tx), .offset = 0};
+    buffer_t buf = {.ptr = coin_transfer_tx, .size = sizeof(coin_transfer_tx), .offset = 0};
 
     parser_status_e status = transaction_deserialize(&buf, &tx);
 
@@ -62,6 +64,8 @@ static void test_tx_deserialization(void **state) {
         0x08, 0x31, 0x11, 0x68, 0xa9, 0xba, 0xc2, 0xf3
     };
     assert_memory_equal(tx.sender, sender, 32);
+    // decoded fields point into the serialized transaction, no copy
+    assert_true(tx.sender == coin_transfer_tx + TX_HASHED_PREFIX_LEN);
     assert_int_equal(tx.sequence, 1);
     assert_int_equal(tx.max_gas_amount, 20000);
     assert_int_equal(tx.gas_unit_price, 100);
@@ -93,8 +97,281 @@ static void test_tx_deserialization(void **state) {
     assert_int_equal(tx.payload.entry_function.args.coin_transfer.amount, 717);
 }
 
+static void test_tx_deserialization_chunked(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static transaction_t tx_one_shot;
+    tx_parser_state_t parser;
+
+    buffer_t buf = {.ptr = coin_transfer_tx, .size = sizeof(coin_transfer_tx), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx_one_shot), PARSING_OK);
+
+    for (size_t chunk_len = 1; chunk_len <= sizeof(coin_transfer_tx); chunk_len++) {
+        transaction_parser_init(&parser, &tx);
+        size_t received = 0;
+        parser_status_e status = PARSING_INCOMPLETE;
+
+        while (received < sizeof(coin_transfer_tx)) {
+            received += chunk_len;
+            if (received > sizeof(coin_transfer_tx)) {
+                received = sizeof(coin_transfer_tx);
+            }
+            buf = (buffer_t){.ptr = coin_transfer_tx, .size = received, .offset = 0};
+            bool more = received < sizeof(coin_transfer_tx);
+            status = transaction_deserialize_chunk(&parser, &buf, &tx, more);
+            if (more) {
+                assert_int_equal(status, PARSING_INCOMPLETE);
+            }
+        }
+
+        assert_int_equal(status, PARSING_OK);
+        assert_int_equal(parser.step, TX_STEP_DONE);
+        assert_memory_equal(&tx, &tx_one_shot, sizeof(tx));
+    }
+}
+
+static void test_tx_deserialization_errors(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static uint8_t raw_tx[sizeof(coin_transfer_tx) + 1];
+    tx_parser_state_t parser;
+
+    // truncated transaction
+    buffer_t buf = {.ptr = coin_transfer_tx, .size = sizeof(coin_transfer_tx) - 1, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), CHAIN_ID_READ_ERROR);
+
+    // trailing byte is rejected as soon as it is received
+    memcpy(raw_tx, coin_transfer_tx, sizeof(coin_transfer_tx));
+    buf = (buffer_t){.ptr = raw_tx, .size = sizeof(raw_tx), .offset = 0};
+    transaction_parser_init(&parser, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&parser, &buf, &tx, true), WRONG_LENGTH_ERROR);
+}
+
+static void test_message_deserialization(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    tx_parser_state_t parser;
+    const uint8_t message[] = "Hello, Aptos! This message is longer than a hashed prefix.";
+    const uint8_t bad_message[] = {0x32, 0xc3, 0x97, 0x32, 0x3d, 0x34};  // 2×2=4
+
+    buffer_t buf = {.ptr = message, .size = 10, .offset = 0};
+    transaction_parser_init(&parser, &tx);
+    assert_int_equal(transaction_deserialize_chunk(&parser, &buf, &tx, true), PARSING_INCOMPLETE);
+    buf = (buffer_t){.ptr = message, .size = 40, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&parser, &buf, &tx, true), PARSING_INCOMPLETE);
+    assert_int_equal(tx.tx_variant, TX_MESSAGE);
+    buf = (buffer_t){.ptr = message, .size = sizeof(message) - 1, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&parser, &buf, &tx, false), PARSING_OK);
+
+    buf = (buffer_t){.ptr = bad_message, .size = sizeof(bad_message), .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), TX_VARIANT_UNDEFINED_ERROR);
+}
+
+static void test_script_deserialization(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    static const uint8_t code[] = {0xa1, 0x1c, 0xeb, 0x0b, 0x05, 0x00, 0x00, 0x00};
+    uint8_t raw[256] = {0};
+    size_t len = 0;
+
+    memcpy(raw + len, coin_transfer_tx, TX_HASHED_PREFIX_LEN + ADDRESS_LEN + 8);
+    len += TX_HASHED_PREFIX_LEN + ADDRESS_LEN + 8;
+    raw[len++] = PAYLOAD_SCRIPT;
+    raw[len++] = sizeof(code);
+    memcpy(raw + len, code, sizeof(code));
+    len += sizeof(code);
+    // type args: vector<u8>
+    raw[len++] = 1;
+    raw[len++] = TYPE_TAG_VECTOR;
+    raw[len++] = TYPE_TAG_U8;
+    // args: u64 717, address 0x1
+    raw[len++] = 2;
+    const size_t u64_arg = len;
+    raw[len++] = SCRIPT_ARG_U64;
+    raw[len++] = 0xcd;
+    raw[len++] = 0x02;
+    len += 6;
+    const size_t address_arg = len;
+    raw[len++] = SCRIPT_ARG_ADDRESS;
+    raw[len + ADDRESS_LEN - 1] = 0x01;
+    len += ADDRESS_LEN;
+    memcpy(raw + len, coin_transfer_tx + sizeof(coin_transfer_tx) - TX_FOOTER_LEN, TX_FOOTER_LEN);
+    len += TX_FOOTER_LEN;
+
+    buffer_t buf = {.ptr = raw, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.payload_variant, PAYLOAD_SCRIPT);
+    assert_int_equal(tx.payload.script.code.len, sizeof(code));
+    assert_memory_equal(tx.payload.script.code.bytes, code, sizeof(code));
+    assert_int_equal(tx.payload.script.ty_size, 1);
+    assert_int_equal(tx.payload.script.ty_args[0].type_tag, TYPE_TAG_VECTOR);
+    assert_int_equal(((type_tag_t *) tx.payload.script.ty_args[0].value)->type_tag, TYPE_TAG_U8);
+    assert_int_equal(tx.payload.script.args_size, 2);
+    assert_true(tx.payload.script.args[0].bytes == raw + u64_arg);
+    assert_int_equal(tx.payload.script.args[0].len, 1 + 8);
+    assert_true(tx.payload.script.args[1].bytes == raw + address_arg);
+    assert_int_equal(tx.payload.script.args[1].len, 1 + ADDRESS_LEN);
+    assert_int_equal(tx.chain_id, 36);
+    const size_t arena_used = tx.arena.used;
+
+    // same transaction received byte by byte
+    tx_parser_state_t parser;
+    transaction_parser_init(&parser, &tx);
+    for (size_t size = 1; size < len; size++) {
+        buf = (buffer_t){.ptr = raw, .size = size, .offset = 0};
+        assert_int_equal(transaction_deserialize_chunk(&parser, &buf, &tx, true),
+                         PARSING_INCOMPLETE);
+    }
+    buf = (buffer_t){.ptr = raw, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&parser, &buf, &tx, false), PARSING_OK);
+    assert_int_equal(tx.payload.script.args[1].len, 1 + ADDRESS_LEN);
+    // retried steps release their arena allocations
+    assert_int_equal(tx.arena.used, arena_used);
+}
+
+static void test_tx_with_data_deserialization(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    uint8_t raw[MAX_TX_LEN] = {0};
+    size_t len = 0;
+
+    memcpy(raw + len, PREFIX_RAW_TX_WITH_DATA_HASHED, TX_HASHED_PREFIX_LEN);
+    len += TX_HASHED_PREFIX_LEN;
+    raw[len++] = TX_WITH_DATA_FEE_PAYER;
+    memcpy(raw + len,
+           coin_transfer_tx + TX_HASHED_PREFIX_LEN,
+           sizeof(coin_transfer_tx) - TX_HASHED_PREFIX_LEN);
+    len += sizeof(coin_transfer_tx) - TX_HASHED_PREFIX_LEN;
+    // two secondary signers 0x..a1 and 0x..a2, fee payer 0x..fe
+    raw[len++] = 2;
+    const size_t signers = len;
+    raw[len + ADDRESS_LEN - 1] = 0xa1;
+    len += ADDRESS_LEN;
+    raw[len + ADDRESS_LEN - 1] = 0xa2;
+    len += ADDRESS_LEN;
+    const size_t fee_payer = len;
+    raw[len + ADDRESS_LEN - 1] = 0xfe;
+    len += ADDRESS_LEN;
+
+    buffer_t buf = {.ptr = raw, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.tx_variant, TX_RAW_WITH_DATA);
+    assert_int_equal(tx.with_data_variant, TX_WITH_DATA_FEE_PAYER);
+    assert_int_equal(tx.payload.entry_function.known_type, FUNC_COIN_TRANSFER);
+    assert_int_equal(tx.payload.entry_function.args.coin_transfer.amount, 717);
+    assert_int_equal(tx.chain_id, 36);
+    assert_int_equal(tx.secondary_signers_size, 2);
+    assert_true(tx.secondary_signers == raw + signers);
+    assert_true(tx.fee_payer == raw + fee_payer);
+
+    // same transaction received byte by byte
+    tx_parser_state_t parser;
+    transaction_parser_init(&parser, &tx);
+    for (size_t size = 1; size < len; size++) {
+        buf = (buffer_t){.ptr = raw, .size = size, .offset = 0};
+        assert_int_equal(transaction_deserialize_chunk(&parser, &buf, &tx, true),
+                         PARSING_INCOMPLETE);
+    }
+    buf = (buffer_t){.ptr = raw, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize_chunk(&parser, &buf, &tx, false), PARSING_OK);
+    assert_true(tx.fee_payer == raw + fee_payer);
+
+    // multi-agent variant has no fee payer
+    raw[TX_HASHED_PREFIX_LEN] = TX_WITH_DATA_MULTI_AGENT;
+    buf = (buffer_t){.ptr = raw, .size = len - ADDRESS_LEN, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(tx.with_data_variant, TX_WITH_DATA_MULTI_AGENT);
+    assert_null(tx.fee_payer);
+    buf = (buffer_t){.ptr = raw, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), WRONG_LENGTH_ERROR);
+
+    raw[TX_HASHED_PREFIX_LEN] = 2;
+    buf = (buffer_t){.ptr = raw, .size = len, .offset = 0};
+    assert_int_equal(transaction_deserialize(&buf, &tx), WITH_DATA_VARIANT_UNDEFINED_ERROR);
+}
+
+static void test_known_function_type(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    uint8_t framework[32] = {0};
+    framework[31] = 0x01;
+    uint8_t other[32] = {0};
+    other[31] = 0x02;
+
+    struct {
+        const char *module;
+        const char *function;
+        uint8_t *address;
+        entry_function_known_type_t type;
+    } cases[] = {
+        {"aptos_account", "transfer", framework, FUNC_APTOS_ACCOUNT_TRANSFER},
+        {"aptos_account", "transfer_coins", framework, FUNC_APTOS_ACCOUNT_TRANSFER_COINS},
+        {"coin", "transfer", framework, FUNC_COIN_TRANSFER},
+        {"coin", "register", framework, FUNC_COIN_REGISTER},
+        {"stake", "add_stake", framework, FUNC_STAKE_ADD_STAKE},
+        {"delegation_pool", "reactivate_stake", framework, FUNC_DELEGATION_POOL_REACTIVATE_STAKE},
+        {"coinX", "transfer", framework, FUNC_UNKNOWN},
+        {"coin", "transferX", framework, FUNC_UNKNOWN},
+        {"coin", "transfe", framework, FUNC_UNKNOWN},
+        {"coin", "transfer", other, FUNC_UNKNOWN},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        tx.payload_variant = PAYLOAD_ENTRY_FUNCTION;
+        tx.payload.entry_function.module_id.address = cases[i].address;
+        tx.payload.entry_function.module_id.name.bytes = (uint8_t *) cases[i].module;
+        tx.payload.entry_function.module_id.name.len = strlen(cases[i].module);
+        tx.payload.entry_function.function_name.bytes = (uint8_t *) cases[i].function;
+        tx.payload.entry_function.function_name.len = strlen(cases[i].function);
+        assert_int_equal(determine_function_type(&tx), cases[i].type);
+    }
+}
+
+static void test_known_function_args(void **state) {
+    (void) state;
+
+    static transaction_t tx;
+    uint8_t pool_address[32] = {0};
+    pool_address[0] = 0xab;
+
+    // delegation_pool::add_stake(pool_address, 1000)
+    uint8_t args[1 + 1 + 1 + 32 + 1 + 8] = {0x00, 0x02, 0x20};
+    memcpy(args + 3, pool_address, sizeof(pool_address));
+    args[35] = 0x08;
+    args[36] = 0xe8;
+    args[37] = 0x03;
+
+    tx.payload_variant = PAYLOAD_ENTRY_FUNCTION;
+    tx.payload.entry_function.known_type = FUNC_DELEGATION_POOL_ADD_STAKE;
+    buffer_t buf = {.ptr = args, .size = sizeof(args), .offset = 0};
+    assert_int_equal(known_function_args_deserialize(&buf, &tx), PARSING_OK);
+    assert_int_equal(buf.offset, sizeof(args));
+    assert_memory_equal(tx.payload.entry_function.args.delegation_pool.pool_address,
+                        pool_address,
+                        32);
+    assert_int_equal(tx.payload.entry_function.args.delegation_pool.amount, 1000);
+
+    // stake::unlock expects a single amount argument
+    tx.payload.entry_function.known_type = FUNC_STAKE_UNLOCK;
+    buf = (buffer_t){.ptr = args, .size = sizeof(args), .offset = 0};
+    assert_int_equal(known_function_args_deserialize(&buf, &tx), ARGS_SIZE_UNEXPECTED_ERROR);
+}
+
 int main() {
-    const struct CMUnitTest tests[] = {cmocka_unit_test(test_tx_deserialization)};
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_tx_deserialization),
+                                       cmocka_unit_test(test_tx_deserialization_chunked),
+                                       cmocka_unit_test(test_tx_deserialization_errors),
+                                       cmocka_unit_test(test_message_deserialization),
+                                       cmocka_unit_test(test_script_deserialization),
+                                       cmocka_unit_test(test_tx_with_data_deserialization),
+                                       cmocka_unit_test(test_known_function_type),
+                                       cmocka_unit_test(test_known_function_args)};
 
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
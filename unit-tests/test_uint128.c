@@ -0,0 +1,96 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <cmocka.h>
+
+#include "common/uint128.h"
+
+static void test_u128_mul_u64(void **state) {
+    (void) state;
+
+    uint128_t r;
+
+    u128_mul_u64(&r, 0, UINT64_MAX);
+    assert_true(u128_is_zero(&r));
+
+    u128_mul_u64(&r, 100, 1000000);
+    assert_int_equal(r.high, 0);
+    assert_int_equal(r.low, 100000000);
+
+    u128_mul_u64(&r, 1ull << 32, 1ull << 32);
+    assert_int_equal(r.high, 1);
+    assert_int_equal(r.low, 0);
+
+    u128_mul_u64(&r, UINT64_MAX, 2);
+    assert_int_equal(r.high, 1);
+    assert_int_equal(r.low, UINT64_MAX - 1);
+
+    // (2^64 - 1)^2 = 2^128 - 2^65 + 1
+    u128_mul_u64(&r, UINT64_MAX, UINT64_MAX);
+    assert_int_equal(r.high, UINT64_MAX - 1);
+    assert_int_equal(r.low, 1);
+
+    u128_mul_u64(&r, 0x123456789abcdef0ull, 0xfedcba9876543210ull);
+    assert_int_equal(r.high, 0x121fa00ad77d7422ull);
+    assert_int_equal(r.low, 0x236d88fe5618cf00ull);
+}
+
+static void test_u128_divmod_u32(void **state) {
+    (void) state;
+
+    uint128_t n = {.high = 0, .low = 1234567890123ull};
+    uint128_t q;
+
+    assert_int_equal(u128_divmod_u32(&q, &n, 1000), 123);
+    assert_int_equal(q.high, 0);
+    assert_int_equal(q.low, 1234567890ull);
+
+    // 2^64 / 10 = 1844674407370955161 remainder 6
+    n = (uint128_t){.high = 1, .low = 0};
+    assert_int_equal(u128_divmod_u32(&q, &n, 10), 6);
+    assert_int_equal(q.high, 0);
+    assert_int_equal(q.low, 1844674407370955161ull);
+
+    // in place, 2^128 - 1 = (2^32 - 1) * (2^96 + 2^64 + 2^32 + 1)
+    n = (uint128_t){.high = UINT64_MAX, .low = UINT64_MAX};
+    assert_int_equal(u128_divmod_u32(&n, &n, 0xffffffff), 0);
+    assert_int_equal(n.high, 0x0000000100000001ull);
+    assert_int_equal(n.low, 0x0000000100000001ull);
+
+    n = (uint128_t){.high = 0, .low = 7};
+    assert_int_equal(u128_divmod_u32(&q, &n, 8), 7);
+    assert_true(u128_is_zero(&q));
+}
+
+static void test_u128_div_pow10(void **state) {
+    (void) state;
+
+    // 2^128 - 1 = 340282366920938463463374607431768211455
+    uint128_t n = {.high = UINT64_MAX, .low = UINT64_MAX};
+    uint128_t q;
+
+    assert_int_equal(u128_div_pow10(&q, &n, 0), 0);
+    assert_int_equal(q.high, UINT64_MAX);
+    assert_int_equal(q.low, UINT64_MAX);
+
+    assert_int_equal(u128_div_pow10(&q, &n, 9), 768211455);
+    assert_int_equal(u128_div_pow10(&q, &q, 9), 374607431);
+    assert_int_equal(u128_div_pow10(&q, &q, 9), 938463463);
+    assert_int_equal(u128_div_pow10(&q, &q, 9), 282366920);
+    assert_int_equal(q.high, 0);
+    assert_int_equal(q.low, 340);
+
+    // larger powers are clamped to 10^9
+    assert_int_equal(u128_div_pow10(&q, &n, 12), 768211455);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_u128_mul_u64),
+                                       cmocka_unit_test(test_u128_divmod_u32),
+                                       cmocka_unit_test(test_u128_div_pow10)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}